@@ -20,6 +20,7 @@ extern "C" {
 #include "FusionCalibration.h"
 #include "FusionCompass.h"
 #include "FusionConvention.h"
+#include "FusionFastMath.h"
 #include "FusionMath.h"
 #include "FusionOffset.h"
 
@@ -36,6 +36,8 @@ static inline FusionVector Feedback(const FusionVector sensor, const FusionVecto
 
 static inline int Clamp(const int value, const int min, const int max);
 
+static inline float Square(const float value);
+
 //------------------------------------------------------------------------------
 // Functions
 
@@ -86,8 +88,8 @@ void FusionAhrsSetSettings(FusionAhrs *const ahrs, const FusionAhrsSettings *con
     ahrs->settings.convention = settings->convention;
     ahrs->settings.gain = settings->gain;
     ahrs->settings.gyroscopeRange = settings->gyroscopeRange == 0.0f ? FLT_MAX : 0.98f * settings->gyroscopeRange;
-    ahrs->settings.accelerationRejection = settings->accelerationRejection == 0.0f ? FLT_MAX : powf(0.5f * sinf(FusionDegreesToRadians(settings->accelerationRejection)), 2);
-    ahrs->settings.magneticRejection = settings->magneticRejection == 0.0f ? FLT_MAX : powf(0.5f * sinf(FusionDegreesToRadians(settings->magneticRejection)), 2);
+    ahrs->settings.accelerationRejection = settings->accelerationRejection == 0.0f ? FLT_MAX : Square(0.5f * sinf(FusionDegreesToRadians(settings->accelerationRejection)));
+    ahrs->settings.magneticRejection = settings->magneticRejection == 0.0f ? FLT_MAX : Square(0.5f * sinf(FusionDegreesToRadians(settings->magneticRejection)));
     ahrs->settings.recoveryTriggerPeriod = settings->recoveryTriggerPeriod;
     ahrs->accelerationRecoveryTimeout = ahrs->settings.recoveryTriggerPeriod;
     ahrs->magneticRecoveryTimeout = ahrs->settings.recoveryTriggerPeriod;
@@ -313,6 +315,15 @@ static inline int Clamp(const int value, const int min, const int max) {
     return value;
 }
 
+/**
+ * @brief Returns the square of the value.
+ * @param value Value.
+ * @return Square of the value.
+ */
+static inline float Square(const float value) {
+    return value * value;
+}
+
 /**
  * @brief Updates the AHRS algorithm using the gyroscope and accelerometer
  * measurements only.
@@ -332,6 +343,115 @@ void FusionAhrsUpdateNoMagnetometer(FusionAhrs *const ahrs, const FusionVector g
     }
 }
 
+/**
+ * @brief Updates the AHRS algorithm with a batch of gyroscope and
+ * accelerometer samples, e.g. a drained sensor FIFO. Equivalent to calling
+ * FusionAhrsUpdateNoMagnetometer for each sample but the quaternion and
+ * acceleration rejection state are kept in local variables across samples
+ * and the convention and gain are resolved once per batch. Samples during
+ * initialisation or with the gyroscope range exceeded take the per-sample
+ * path.
+ * @param ahrs AHRS algorithm structure.
+ * @param samples Samples, oldest first.
+ * @param numberOfSamples Number of samples.
+ * @param deltaTimes Delta time in seconds of each sample. NULL if all
+ * samples use deltaTime.
+ * @param deltaTime Delta time in seconds used if deltaTimes is NULL.
+ * @param offset Gyroscope offset algorithm structure updated with each
+ * sample before the AHRS update. NULL if not used.
+ */
+void FusionAhrsUpdateNoMagnetometerBatch(FusionAhrs *const ahrs, const FusionAhrsSample *const samples, const size_t numberOfSamples, const float *const deltaTimes, const float deltaTime, FusionOffset *const offset) {
+    const float gyroscopeRange = ahrs->settings.gyroscopeRange;
+    const float accelerationRejection = ahrs->settings.accelerationRejection;
+    const int recoveryTriggerPeriod = (int) ahrs->settings.recoveryTriggerPeriod;
+    const float gravitySign = ahrs->settings.convention == FusionConventionNed ? -1.0f : 1.0f; // see HalfGravity
+
+    FusionQuaternion quaternion = ahrs->quaternion;
+    FusionVector halfAccelerometerFeedback = ahrs->halfAccelerometerFeedback;
+    bool accelerometerIgnored = ahrs->accelerometerIgnored;
+    int accelerationRecoveryTrigger = ahrs->accelerationRecoveryTrigger;
+    int accelerationRecoveryTimeout = ahrs->accelerationRecoveryTimeout;
+    float rampedGain = ahrs->rampedGain;
+    bool fast = false; // locals hold the latest state
+
+    for (size_t index = 0; index < numberOfSamples; index++) {
+        const FusionVector accelerometer = samples[index].accelerometer;
+        const float sampleDeltaTime = deltaTimes == NULL ? deltaTime : deltaTimes[index];
+        FusionVector gyroscope = samples[index].gyroscope;
+        if (offset != NULL) {
+            gyroscope = FusionOffsetUpdate(offset, gyroscope);
+        }
+
+        // Initialisation and gyroscope range recovery use the per-sample update
+        if (ahrs->initialising || (fabsf(gyroscope.axis.x) > gyroscopeRange) || (fabsf(gyroscope.axis.y) > gyroscopeRange) || (fabsf(gyroscope.axis.z) > gyroscopeRange)) {
+            if (fast) {
+                ahrs->quaternion = quaternion;
+                ahrs->halfAccelerometerFeedback = halfAccelerometerFeedback;
+                ahrs->accelerometerIgnored = accelerometerIgnored;
+                ahrs->accelerationRecoveryTrigger = accelerationRecoveryTrigger;
+                ahrs->accelerationRecoveryTimeout = accelerationRecoveryTimeout;
+                fast = false;
+            }
+            FusionAhrsUpdateNoMagnetometer(ahrs, gyroscope, accelerometer, sampleDeltaTime);
+            quaternion = ahrs->quaternion;
+            halfAccelerometerFeedback = ahrs->halfAccelerometerFeedback;
+            accelerometerIgnored = ahrs->accelerometerIgnored;
+            accelerationRecoveryTrigger = ahrs->accelerationRecoveryTrigger;
+            accelerationRecoveryTimeout = ahrs->accelerationRecoveryTimeout;
+            rampedGain = ahrs->rampedGain;
+            continue;
+        }
+        fast = true;
+
+#define Q quaternion.element
+        // Calculate direction of gravity indicated by algorithm
+        const FusionVector halfGravity = FusionVectorMultiplyScalar((FusionVector) {.axis = {
+                .x = Q.x * Q.z - Q.w * Q.y,
+                .y = Q.y * Q.z + Q.w * Q.x,
+                .z = Q.w * Q.w - 0.5f + Q.z * Q.z,
+        }}, gravitySign);
+#undef Q
+
+        // Calculate accelerometer feedback
+        FusionVector appliedFeedback = FUSION_VECTOR_ZERO;
+        accelerometerIgnored = true;
+        if (FusionVectorIsZero(accelerometer) == false) {
+            halfAccelerometerFeedback = Feedback(FusionVectorNormalise(accelerometer), halfGravity);
+            if (FusionVectorMagnitudeSquared(halfAccelerometerFeedback) <= accelerationRejection) {
+                accelerometerIgnored = false;
+                accelerationRecoveryTrigger -= 9;
+            } else {
+                accelerationRecoveryTrigger += 1;
+            }
+            if (accelerationRecoveryTrigger > accelerationRecoveryTimeout) {
+                accelerationRecoveryTimeout = 0;
+                accelerometerIgnored = false;
+            } else {
+                accelerationRecoveryTimeout = recoveryTriggerPeriod;
+            }
+            accelerationRecoveryTrigger = Clamp(accelerationRecoveryTrigger, 0, recoveryTriggerPeriod);
+            if (accelerometerIgnored == false) {
+                appliedFeedback = halfAccelerometerFeedback;
+            }
+        }
+
+        // Apply feedback to gyroscope and integrate
+        const FusionVector halfGyroscope = FusionVectorMultiplyScalar(gyroscope, FusionDegreesToRadians(0.5f));
+        const FusionVector adjustedHalfGyroscope = FusionVectorAdd(halfGyroscope, FusionVectorMultiplyScalar(appliedFeedback, rampedGain));
+        quaternion = FusionQuaternionNormalise(FusionQuaternionAdd(quaternion, FusionQuaternionMultiplyVector(quaternion, FusionVectorMultiplyScalar(adjustedHalfGyroscope, sampleDeltaTime))));
+    }
+
+    if (fast) {
+        ahrs->quaternion = quaternion;
+        ahrs->accelerometer = samples[numberOfSamples - 1].accelerometer;
+        ahrs->halfAccelerometerFeedback = halfAccelerometerFeedback;
+        ahrs->accelerometerIgnored = accelerometerIgnored;
+        ahrs->accelerationRecoveryTrigger = accelerationRecoveryTrigger;
+        ahrs->accelerationRecoveryTimeout = accelerationRecoveryTimeout;
+        ahrs->magnetometerIgnored = true;
+    }
+}
+
 /**
  * @brief Updates the AHRS algorithm using the gyroscope, accelerometer, and
  * heading measurements.
@@ -345,15 +465,15 @@ void FusionAhrsUpdateExternalHeading(FusionAhrs *const ahrs, const FusionVector
 #define Q ahrs->quaternion.element
 
     // Calculate roll
-    const float roll = atan2f(Q.w * Q.x + Q.y * Q.z, 0.5f - Q.y * Q.y - Q.x * Q.x);
+    const float roll = FusionAtan2(Q.w * Q.x + Q.y * Q.z, 0.5f - Q.y * Q.y - Q.x * Q.x);
 
     // Calculate magnetometer
     const float headingRadians = FusionDegreesToRadians(heading);
-    const float sinHeadingRadians = sinf(headingRadians);
+    const float sinHeadingRadians = FusionSin(headingRadians);
     const FusionVector magnetometer = {.axis = {
-            .x = cosf(headingRadians),
-            .y = -1.0f * cosf(roll) * sinHeadingRadians,
-            .z = sinHeadingRadians * sinf(roll),
+            .x = FusionCos(headingRadians),
+            .y = -1.0f * FusionCos(roll) * sinHeadingRadians,
+            .z = sinHeadingRadians * FusionSin(roll),
     }};
 
     // Update AHRS algorithm
@@ -494,13 +614,13 @@ FusionAhrsFlags FusionAhrsGetFlags(const FusionAhrs *const ahrs) {
  */
 void FusionAhrsSetHeading(FusionAhrs *const ahrs, const float heading) {
 #define Q ahrs->quaternion.element
-    const float yaw = atan2f(Q.w * Q.z + Q.x * Q.y, 0.5f - Q.y * Q.y - Q.z * Q.z);
+    const float yaw = FusionAtan2(Q.w * Q.z + Q.x * Q.y, 0.5f - Q.y * Q.y - Q.z * Q.z);
     const float halfYawMinusHeading = 0.5f * (yaw - FusionDegreesToRadians(heading));
     const FusionQuaternion rotation = {.element = {
-            .w = cosf(halfYawMinusHeading),
+            .w = FusionCos(halfYawMinusHeading),
             .x = 0.0f,
             .y = 0.0f,
-            .z = -1.0f * sinf(halfYawMinusHeading),
+            .z = -1.0f * FusionSin(halfYawMinusHeading),
     }};
     ahrs->quaternion = FusionQuaternionMultiply(rotation, ahrs->quaternion);
 #undef Q
@@ -13,7 +13,9 @@
 
 #include "FusionConvention.h"
 #include "FusionMath.h"
+#include "FusionOffset.h"
 #include <stdbool.h>
+#include <stddef.h>
 
 //------------------------------------------------------------------------------
 // Definitions
@@ -52,6 +54,14 @@ typedef struct {
     int magneticRecoveryTimeout;
 } FusionAhrs;
 
+/**
+ * @brief Gyroscope and accelerometer sample for the batch update.
+ */
+typedef struct {
+    FusionVector gyroscope;
+    FusionVector accelerometer;
+} FusionAhrsSample;
+
 /**
  * @brief AHRS algorithm internal states.
  */
@@ -87,6 +97,8 @@ void FusionAhrsUpdate(FusionAhrs *const ahrs, const FusionVector gyroscope, cons
 
 void FusionAhrsUpdateNoMagnetometer(FusionAhrs *const ahrs, const FusionVector gyroscope, const FusionVector accelerometer, const float deltaTime);
 
+void FusionAhrsUpdateNoMagnetometerBatch(FusionAhrs *const ahrs, const FusionAhrsSample *const samples, const size_t numberOfSamples, const float *const deltaTimes, const float deltaTime, FusionOffset *const offset);
+
 void FusionAhrsUpdateExternalHeading(FusionAhrs *const ahrs, const FusionVector gyroscope, const FusionVector accelerometer, const float heading, const float deltaTime);
 
 FusionQuaternion FusionAhrsGetQuaternion(const FusionAhrs *const ahrs);
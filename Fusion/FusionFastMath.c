@@ -0,0 +1,95 @@
+/**
+ * @file FusionFastMath.c
+ * @brief Fast approximations of the trigonometric and square root functions
+ * used by the library, for targets where float operations go through a
+ * software library (e.g. RP2040). Selected with FUSION_USE_FAST_MATH.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "FusionFastMath.h"
+
+//------------------------------------------------------------------------------
+// Variables
+
+/**
+ * @brief sin(pi / 2 * i / FUSION_SINE_TABLE_SIZE).
+ */
+const float fusionSineTable[FUSION_SINE_TABLE_SIZE + 1] = {
+        0.00000000f, 0.01227154f, 0.02454123f, 0.03680722f, 0.04906767f, 0.06132074f,
+        0.07356456f, 0.08579731f, 0.09801714f, 0.11022221f, 0.12241068f, 0.13458071f,
+        0.14673047f, 0.15885814f, 0.17096189f, 0.18303989f, 0.19509032f, 0.20711138f,
+        0.21910124f, 0.23105811f, 0.24298018f, 0.25486566f, 0.26671276f, 0.27851969f,
+        0.29028468f, 0.30200595f, 0.31368174f, 0.32531029f, 0.33688985f, 0.34841868f,
+        0.35989504f, 0.37131719f, 0.38268343f, 0.39399204f, 0.40524131f, 0.41642956f,
+        0.42755509f, 0.43861624f, 0.44961133f, 0.46053871f, 0.47139674f, 0.48218377f,
+        0.49289819f, 0.50353838f, 0.51410274f, 0.52458968f, 0.53499762f, 0.54532499f,
+        0.55557023f, 0.56573181f, 0.57580819f, 0.58579786f, 0.59569930f, 0.60551104f,
+        0.61523159f, 0.62485949f, 0.63439328f, 0.64383154f, 0.65317284f, 0.66241578f,
+        0.67155895f, 0.68060100f, 0.68954054f, 0.69837625f, 0.70710678f, 0.71573083f,
+        0.72424708f, 0.73265427f, 0.74095113f, 0.74913639f, 0.75720885f, 0.76516727f,
+        0.77301045f, 0.78073723f, 0.78834643f, 0.79583690f, 0.80320753f, 0.81045720f,
+        0.81758481f, 0.82458930f, 0.83146961f, 0.83822471f, 0.84485357f, 0.85135519f,
+        0.85772861f, 0.86397286f, 0.87008699f, 0.87607009f, 0.88192126f, 0.88763962f,
+        0.89322430f, 0.89867447f, 0.90398929f, 0.90916798f, 0.91420976f, 0.91911385f,
+        0.92387953f, 0.92850608f, 0.93299280f, 0.93733901f, 0.94154407f, 0.94560733f,
+        0.94952818f, 0.95330604f, 0.95694034f, 0.96043052f, 0.96377607f, 0.96697647f,
+        0.97003125f, 0.97293995f, 0.97570213f, 0.97831737f, 0.98078528f, 0.98310549f,
+        0.98527764f, 0.98730142f, 0.98917651f, 0.99090264f, 0.99247953f, 0.99390697f,
+        0.99518473f, 0.99631261f, 0.99729046f, 0.99811811f, 0.99879546f, 0.99932238f,
+        0.99969882f, 0.99992470f, 1.00000000f,
+};
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Returns the sine with the angle in table units (FUSION_SINE_TABLE_SIZE
+ * per quarter period), interpolating linearly between table entries.
+ * @param units Angle in table units.
+ * @return Sine.
+ */
+static float SineUnits(const float units) {
+    int32_t index = (int32_t) units;
+    if ((float) index > units) {
+        index--; // floor for negative angles
+    }
+    const float fraction = units - (float) index;
+    index &= (4 * FUSION_SINE_TABLE_SIZE) - 1;
+    const int32_t quadrant = index / FUSION_SINE_TABLE_SIZE;
+    const int32_t offset = index % FUSION_SINE_TABLE_SIZE;
+
+    float a;
+    float b;
+    if ((quadrant & 1) == 0) {
+        a = fusionSineTable[offset];
+        b = fusionSineTable[offset + 1];
+    } else {
+        a = fusionSineTable[FUSION_SINE_TABLE_SIZE - offset];
+        b = fusionSineTable[FUSION_SINE_TABLE_SIZE - offset - 1];
+    }
+    const float sine = a + (b - a) * fraction;
+    return quadrant >= 2 ? -sine : sine;
+}
+
+/**
+ * @brief Returns the sine of the angle.
+ * @param radians Angle in radians.
+ * @return Sine.
+ */
+float FusionFastSin(const float radians) {
+    return SineUnits(radians * (2.0f * FUSION_SINE_TABLE_SIZE / 3.14159265f));
+}
+
+/**
+ * @brief Returns the cosine of the angle.
+ * @param radians Angle in radians.
+ * @return Cosine.
+ */
+float FusionFastCos(const float radians) {
+    return SineUnits(radians * (2.0f * FUSION_SINE_TABLE_SIZE / 3.14159265f) + FUSION_SINE_TABLE_SIZE);
+}
+
+//------------------------------------------------------------------------------
+// End of file
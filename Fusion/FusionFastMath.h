@@ -0,0 +1,123 @@
+/**
+ * @file FusionFastMath.h
+ * @brief Fast approximations of the trigonometric and square root functions
+ * used by the library, for targets where float operations go through a
+ * software library (e.g. RP2040). Selected with FUSION_USE_FAST_MATH.
+ *
+ * Maximum absolute errors over the full input range, measured on the host
+ * against libm by tools/fusion_math_bench.c:
+ *
+ *   FusionFastAtan2               1.2e-5 rad (0.0007 degrees)
+ *   FusionFastAsin                7.5e-5 rad (0.0043 degrees)
+ *   FusionFastSin, FusionFastCos  2.3e-5 for |radians| <= 100
+ *   FusionFastInverseSqrtRefined  4.7e-6 relative
+ */
+
+#ifndef FUSION_FAST_MATH_H
+#define FUSION_FAST_MATH_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <math.h>
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Number of sine table intervals per quarter period.
+ */
+#define FUSION_SINE_TABLE_SIZE (128)
+
+/**
+ * @brief Sine of a quarter period, FUSION_SINE_TABLE_SIZE + 1 entries.
+ */
+extern const float fusionSineTable[FUSION_SINE_TABLE_SIZE + 1];
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+float FusionFastSin(const float radians);
+
+float FusionFastCos(const float radians);
+
+//------------------------------------------------------------------------------
+// Inline functions
+
+/**
+ * @brief Calculates the reciprocal of the square root using the bit-level
+ * estimate followed by two Newton-Raphson iterations.
+ * @param x Operand. Must be positive.
+ * @return Reciprocal of the square root of x.
+ */
+static inline float FusionFastInverseSqrtRefined(const float x) {
+
+    typedef union {
+        float f;
+        int32_t i;
+    } Union32;
+
+    Union32 union32 = {.f = x};
+    union32.i = 0x5F375A86 - (union32.i >> 1);
+    const float halfX = 0.5f * x;
+    float y = union32.f;
+    y = y * (1.5f - halfX * y * y);
+    y = y * (1.5f - halfX * y * y);
+    return y;
+}
+
+/**
+ * @brief Calculates the square root as x times its reciprocal square root.
+ * @param x Operand.
+ * @return Square root of x, 0 if x is not positive.
+ */
+static inline float FusionFastSqrt(const float x) {
+    if (x <= 0.0f) {
+        return 0.0f;
+    }
+    return x * FusionFastInverseSqrtRefined(x);
+}
+
+/**
+ * @brief Calculates the arc tangent of y / x using the quadrant of (x, y).
+ * Polynomial from Abramowitz and Stegun 4.4.47 on the octant [0, 1].
+ * @param y Y.
+ * @param x X.
+ * @return Angle in radians, -pi to pi.
+ */
+static inline float FusionFastAtan2(const float y, const float x) {
+    const float absX = fabsf(x);
+    const float absY = fabsf(y);
+    const float maximum = absX > absY ? absX : absY;
+    if (maximum == 0.0f) {
+        return 0.0f;
+    }
+    const float z = (absX > absY ? absY : absX) / maximum;
+    const float zSquared = z * z;
+    float angle = z * (0.9998660f + zSquared * (-0.3302995f + zSquared * (0.1801410f + zSquared * (-0.0851330f + zSquared * 0.0208351f))));
+    if (absY > absX) {
+        angle = 1.57079633f - angle;
+    }
+    if (x < 0.0f) {
+        angle = 3.14159265f - angle;
+    }
+    return y < 0.0f ? -angle : angle;
+}
+
+/**
+ * @brief Calculates the arc sine. Polynomial from Abramowitz and Stegun
+ * 4.4.45.
+ * @param value Value, -1 to 1.
+ * @return Arc sine in radians.
+ */
+static inline float FusionFastAsin(const float value) {
+    const float absValue = fabsf(value);
+    const float angle = 1.57079633f - FusionFastSqrt(1.0f - absValue) * (1.5707288f + absValue * (-0.2121144f + absValue * (0.0742610f + absValue * -0.0187293f)));
+    return value < 0.0f ? -angle : angle;
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
@@ -10,6 +10,7 @@
 //------------------------------------------------------------------------------
 // Includes
 
+#include "FusionFastMath.h"
 #include <math.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -116,6 +117,13 @@ typedef union {
  */
 //#define FUSION_USE_NORMAL_SQRT
 
+/**
+ * @brief Include this definition or add as a preprocessor definition to use
+ * the approximations in FusionFastMath.h for arc sine, arc tangent, sine and
+ * cosine instead of libm.
+ */
+//#define FUSION_USE_FAST_MATH
+
 //------------------------------------------------------------------------------
 // Inline functions - Degrees and radians conversion
 
@@ -152,7 +160,54 @@ static inline float FusionAsin(const float value) {
     if (value >= 1.0f) {
         return (float) M_PI / 2.0f;
     }
+#ifdef FUSION_USE_FAST_MATH
+    return FusionFastAsin(value);
+#else
     return asinf(value);
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Inline functions - Arc tangent, sine and cosine
+
+/**
+ * @brief Returns the arc tangent of y / x using the quadrant of (x, y).
+ * @param y Y.
+ * @param x X.
+ * @return Angle in radians.
+ */
+static inline float FusionAtan2(const float y, const float x) {
+#ifdef FUSION_USE_FAST_MATH
+    return FusionFastAtan2(y, x);
+#else
+    return atan2f(y, x);
+#endif
+}
+
+/**
+ * @brief Returns the sine of the angle.
+ * @param radians Angle in radians.
+ * @return Sine.
+ */
+static inline float FusionSin(const float radians) {
+#ifdef FUSION_USE_FAST_MATH
+    return FusionFastSin(radians);
+#else
+    return sinf(radians);
+#endif
+}
+
+/**
+ * @brief Returns the cosine of the angle.
+ * @param radians Angle in radians.
+ * @return Cosine.
+ */
+static inline float FusionCos(const float radians) {
+#ifdef FUSION_USE_FAST_MATH
+    return FusionFastCos(radians);
+#else
+    return cosf(radians);
+#endif
 }
 
 //------------------------------------------------------------------------------
@@ -467,9 +522,9 @@ static inline FusionEuler FusionQuaternionToEuler(const FusionQuaternion quatern
 #define Q quaternion.element
     const float halfMinusQySquared = 0.5f - Q.y * Q.y; // calculate common terms to avoid repeated operations
     const FusionEuler euler = {.angle = {
-            .roll = FusionRadiansToDegrees(atan2f(Q.w * Q.x + Q.y * Q.z, halfMinusQySquared - Q.x * Q.x)),
+            .roll = FusionRadiansToDegrees(FusionAtan2(Q.w * Q.x + Q.y * Q.z, halfMinusQySquared - Q.x * Q.x)),
             .pitch = FusionRadiansToDegrees(FusionAsin(2.0f * (Q.w * Q.y - Q.z * Q.x))),
-            .yaw = FusionRadiansToDegrees(atan2f(Q.w * Q.z + Q.x * Q.y, halfMinusQySquared - Q.z * Q.z)),
+            .yaw = FusionRadiansToDegrees(FusionAtan2(Q.w * Q.z + Q.x * Q.y, halfMinusQySquared - Q.z * Q.z)),
     }};
     return euler;
 #undef Q
@@ -11,7 +11,7 @@
 #define configUSE_TICKLESS_IDLE                 0
 #define configCPU_CLOCK_HZ                      133000000
 #define configTICK_RATE_HZ                      100
-#define configMAX_PRIORITIES                    5
+#define configMAX_PRIORITIES                    6
 #define configMINIMAL_STACK_SIZE                128
 #define configMAX_TASK_NAME_LEN                 16
 #define configUSE_16_BIT_TICKS                  0
@@ -31,29 +31,70 @@
 #define configMESSAGE_BUFFER_LENGTH_TYPE        size_t
 
 /* Memory allocation related definitions. */
+#if RTOS_STATIC_ALLOCATION
+/* Tasks, filas e semaforos em buffers estaticos (ver main/rtos_static.h) */
+#define configSUPPORT_STATIC_ALLOCATION         1
+#define configSUPPORT_DYNAMIC_ALLOCATION        0
+#else
 #define configSUPPORT_STATIC_ALLOCATION         0
 #define configSUPPORT_DYNAMIC_ALLOCATION        1
+#endif
+
+/* Classes do heap_pool.c: X(tamanho do bloco em bytes, quantidade de blocos).
+ * Em ordem crescente; tamanhos multiplos de portBYTE_ALIGNMENT (8).
+ *
+ * Objetos do kernel; tools/stack_usage.py le esta lista e, com
+ * STACK_USAGE_ANALYSIS, o stack_sizes.h gerado define configHEAP_POOL_CLASSES
+ * somando um bloco do tamanho calculado para cada pilha de task. */
+#define configHEAP_POOL_OBJECT_CLASSES(X) \
+    X(128, 16)    /* 10 TCBs, event group, timer + folga */ \
+    X(256, 2)     /* fila do timer */                   \
+    X(512, 4)     /* pilhas idle/timer */
+
+#if defined(HAVE_STACK_SIZES_H)
+#include "stack_sizes.h"
+#else
+/* Sem a analise: pilhas padrao de main/task_config.h */
+#define configHEAP_POOL_CLASSES(X) \
+    configHEAP_POOL_OBJECT_CLASSES(X) \
+    X(1024, 6)    /* pilhas 256 w */                    \
+    X(2048, 4)    /* pilhas 512 w (Button, HUD) + folga */ \
+    X(16384, 1)   /* pilha UART_Task */                 \
+    X(32768, 1)   /* pilha mpu6050_Task */
+#endif
 #define configAPPLICATION_ALLOCATED_HEAP        1
 
 /* Hook function related definitions. */
 #define configUSE_IDLE_HOOK                     0
 #define configUSE_TICK_HOOK                     0
+/* Pilhas calculadas (STACK_USAGE_ANALYSIS) tem pouca folga: o metodo 2
+ * confere o padrao no fim da pilha a cada troca de contexto e chama
+ * vApplicationStackOverflowHook (main/rtos_static.c). */
+#if RTOS_STACK_OVERFLOW_CHECK
+#define configCHECK_FOR_STACK_OVERFLOW          2
+#else
 #define configCHECK_FOR_STACK_OVERFLOW          0
+#endif
 #define configUSE_MALLOC_FAILED_HOOK            0
 #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
 
 /* Run time and task stats gathering related definitions. */
-#define configGENERATE_RUN_TIME_STATS           0
-#define configUSE_TRACE_FACILITY                0
+#define configGENERATE_RUN_TIME_STATS           1
+#define configUSE_TRACE_FACILITY                1
 #define configUSE_STATS_FORMATTING_FUNCTIONS    0
 
+/* Run time stats clock: RP2040 1 MHz timer, always running, no setup needed. */
+#include "hardware/timer.h"
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()        time_us_32()
+
 /* Co-routine related definitions. */
 #define configUSE_CO_ROUTINES                   0
 #define configMAX_CO_ROUTINE_PRIORITIES         1
 
 /* Software timer related definitions. */
 #define configUSE_TIMERS                        1
-#define configTIMER_TASK_PRIORITY               3
+#define configTIMER_TASK_PRIORITY               1
 #define configTIMER_QUEUE_LENGTH                10
 #define configTIMER_TASK_STACK_DEPTH            configMINIMAL_STACK_SIZE
 
@@ -70,8 +111,8 @@
 #define INCLUDE_vTaskDelay                      1
 #define INCLUDE_xTaskGetSchedulerState          1
 #define INCLUDE_xTaskGetCurrentTaskHandle       1
-#define INCLUDE_uxTaskGetStackHighWaterMark     0
-#define INCLUDE_xTaskGetIdleTaskHandle          0
+#define INCLUDE_uxTaskGetStackHighWaterMark     1
+#define INCLUDE_xTaskGetIdleTaskHandle          1 /* ulTaskGetIdleRunTimeCounter (HUD) */
 #define INCLUDE_eTaskGetState                   0
 #define INCLUDE_xEventGroupSetBitFromISR        1
 #define INCLUDE_xTimerPendFunctionCall          0
@@ -80,5 +121,6 @@
 #define INCLUDE_xTaskResumeFromISR              1
 
 /* A header file that defines trace macro can be included here. */
+#include "trace_recorder.h"
 
 #endif /* FREERTOS_CONFIG_H */
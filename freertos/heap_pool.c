@@ -0,0 +1,248 @@
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "heap_pool.h"
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#ifndef configHEAP_POOL_CLASSES
+    #error configHEAP_POOL_CLASSES must be defined in FreeRTOSConfig.h
+#endif
+
+typedef struct free_block {
+    struct free_block *next;
+} free_block_t;
+
+typedef struct {
+    uint8_t *base;
+    uint16_t *requested; /* tamanho pedido de cada bloco em uso */
+    free_block_t *free_list;
+    heap_pool_class_stats_t stats;
+} pool_class_t;
+
+/* Um array estatico de blocos (alinhados a portBYTE_ALIGNMENT) por classe */
+#define POOL_STORAGE(size, count)                                                              \
+    static uint8_t pool_storage_##size[(size) * (count)] __attribute__((aligned(portBYTE_ALIGNMENT))); \
+    static uint16_t pool_requested_##size[count];
+configHEAP_POOL_CLASSES(POOL_STORAGE)
+
+#define POOL_CLASS(size, count) \
+    {pool_storage_##size, pool_requested_##size, NULL, {(size), (count), 0, 0, 0, 0, 0, 0}},
+static pool_class_t pool_classes[] = {configHEAP_POOL_CLASSES(POOL_CLASS)};
+
+#define POOL_CLASS_COUNT (sizeof(pool_classes) / sizeof(pool_classes[0]))
+
+static size_t pool_free_bytes;
+static size_t pool_min_free_bytes;
+static size_t pool_successful_allocs;
+static size_t pool_successful_frees;
+static BaseType_t pool_initialised = pdFALSE;
+
+static void pool_init(void) {
+    pool_free_bytes = 0;
+
+    for (size_t c = 0; c < POOL_CLASS_COUNT; c++) {
+        pool_class_t *pc = &pool_classes[c];
+        uint32_t size = pc->stats.block_size;
+
+        configASSERT((size % portBYTE_ALIGNMENT) == 0);
+        configASSERT(c == 0 || size > pool_classes[c - 1].stats.block_size);
+
+        pc->free_list = NULL;
+        for (int i = pc->stats.blocks - 1; i >= 0; i--) {
+            free_block_t *b = (free_block_t *)(pc->base + i * size);
+            b->next = pc->free_list;
+            pc->free_list = b;
+        }
+        pool_free_bytes += size * pc->stats.blocks;
+    }
+
+    pool_min_free_bytes = pool_free_bytes;
+    pool_initialised = pdTRUE;
+}
+
+static pool_class_t *pool_owner(const uint8_t *p) {
+    for (size_t c = 0; c < POOL_CLASS_COUNT; c++) {
+        pool_class_t *pc = &pool_classes[c];
+        if (p >= pc->base && p < pc->base + pc->stats.block_size * pc->stats.blocks) {
+            return pc;
+        }
+    }
+    return NULL;
+}
+
+void *pvPortMalloc(size_t xWantedSize) {
+    void *pvReturn = NULL;
+
+    if (xWantedSize == 0) {
+        return NULL;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        if (pool_initialised == pdFALSE) {
+            pool_init();
+        }
+
+        /* Classes ordenadas por tamanho: a primeira que cabe e a ideal; se
+         * estiver vazia, usa a classe seguinte (conta como spill). Nao sobe
+         * mais que isso para um pedido pequeno nao tomar o bloco de uma pilha. */
+        size_t first = 0;
+        while (first < POOL_CLASS_COUNT && pool_classes[first].stats.block_size < xWantedSize) {
+            first++;
+        }
+        pool_class_t *ideal = first < POOL_CLASS_COUNT ? &pool_classes[first] : NULL;
+
+        for (size_t c = first; c < POOL_CLASS_COUNT && c <= first + 1; c++) {
+            pool_class_t *pc = &pool_classes[c];
+            if (pc->free_list == NULL) {
+                continue;
+            }
+
+            free_block_t *b = pc->free_list;
+            pc->free_list = b->next;
+
+            uint32_t index = ((uint8_t *)b - pc->base) / pc->stats.block_size;
+            pc->requested[index] = (uint16_t)(xWantedSize > UINT16_MAX ? UINT16_MAX : xWantedSize);
+
+            pc->stats.in_use++;
+            pc->stats.allocs++;
+            pc->stats.requested += pc->requested[index];
+            if (pc->stats.in_use > pc->stats.peak_in_use) {
+                pc->stats.peak_in_use = pc->stats.in_use;
+            }
+            if (pc != ideal) {
+                pc->stats.spills++;
+            }
+
+            pool_free_bytes -= pc->stats.block_size;
+            if (pool_free_bytes < pool_min_free_bytes) {
+                pool_min_free_bytes = pool_free_bytes;
+            }
+            pool_successful_allocs++;
+
+            pvReturn = b;
+            break;
+        }
+
+        if (pvReturn == NULL && ideal != NULL) {
+            ideal->stats.failures++;
+        }
+        traceMALLOC(pvReturn, xWantedSize);
+    }
+    taskEXIT_CRITICAL();
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+        {
+            if( pvReturn == NULL )
+            {
+                extern void vApplicationMallocFailedHook( void );
+                vApplicationMallocFailedHook();
+            }
+        }
+    #endif
+
+    return pvReturn;
+}
+
+void vPortFree(void *pv) {
+    if (pv == NULL) {
+        return;
+    }
+
+    pool_class_t *pc = pool_owner(pv);
+    configASSERT(pc != NULL);
+    if (pc == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        uint32_t index = ((uint8_t *)pv - pc->base) / pc->stats.block_size;
+        pc->stats.requested -= pc->requested[index];
+        pc->requested[index] = 0;
+
+        free_block_t *b = pv;
+        b->next = pc->free_list;
+        pc->free_list = b;
+
+        pc->stats.in_use--;
+        pool_free_bytes += pc->stats.block_size;
+        pool_successful_frees++;
+        traceFREE(pv, pc->stats.block_size);
+    }
+    taskEXIT_CRITICAL();
+}
+
+size_t xPortGetFreeHeapSize(void) {
+    return pool_free_bytes;
+}
+
+size_t xPortGetMinimumEverFreeHeapSize(void) {
+    return pool_min_free_bytes;
+}
+
+void vPortGetHeapStats(HeapStats_t *pxHeapStats) {
+    size_t largest = 0, smallest = SIZE_MAX, free_blocks = 0;
+
+    taskENTER_CRITICAL();
+    {
+        for (size_t c = 0; c < POOL_CLASS_COUNT; c++) {
+            const heap_pool_class_stats_t *s = &pool_classes[c].stats;
+            uint16_t free_here = s->blocks - s->in_use;
+            if (free_here == 0) {
+                continue;
+            }
+            free_blocks += free_here;
+            if (s->block_size > largest) {
+                largest = s->block_size;
+            }
+            if (s->block_size < smallest) {
+                smallest = s->block_size;
+            }
+        }
+        pxHeapStats->xAvailableHeapSpaceInBytes = pool_free_bytes;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = pool_min_free_bytes;
+        pxHeapStats->xNumberOfSuccessfulAllocations = pool_successful_allocs;
+        pxHeapStats->xNumberOfSuccessfulFrees = pool_successful_frees;
+    }
+    taskEXIT_CRITICAL();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = largest;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = free_blocks ? smallest : 0;
+    pxHeapStats->xNumberOfFreeBlocks = free_blocks;
+}
+
+size_t heap_pool_class_count(void) {
+    return POOL_CLASS_COUNT;
+}
+
+void heap_pool_get_class_stats(size_t index, heap_pool_class_stats_t *stats) {
+    taskENTER_CRITICAL();
+    *stats = pool_classes[index].stats;
+    taskEXIT_CRITICAL();
+}
+
+size_t heap_pool_wasted_bytes(void) {
+    size_t wasted = 0;
+
+    taskENTER_CRITICAL();
+    for (size_t c = 0; c < POOL_CLASS_COUNT; c++) {
+        const heap_pool_class_stats_t *s = &pool_classes[c].stats;
+        wasted += s->block_size * s->in_use - s->requested;
+    }
+    taskEXIT_CRITICAL();
+
+    return wasted;
+}
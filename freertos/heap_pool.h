@@ -0,0 +1,37 @@
+/*
+ * Fixed-block pool allocator for the FreeRTOS heap (replaces heap_3).
+ *
+ * Memory is split into size classes (configHEAP_POOL_CLASSES in
+ * FreeRTOSConfig.h). Each class is a static array of equal blocks threaded on
+ * a free list, so pvPortMalloc/vPortFree are O(1) and run in a short critical
+ * section instead of suspending the scheduler around newlib malloc.
+ */
+#ifndef HEAP_POOL_H
+#define HEAP_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+    uint32_t block_size;
+    uint16_t blocks;
+    uint16_t in_use;
+    uint16_t peak_in_use;
+    uint16_t spills;        /* pedidos atendidos aqui por falta na classe ideal */
+    uint32_t allocs;
+    uint32_t failures;      /* pedidos sem bloco livre nesta classe ou acima */
+    uint32_t requested;     /* bytes pedidos pelos blocos em uso */
+} heap_pool_class_stats_t;
+
+/* Number of size classes configured. */
+size_t heap_pool_class_count(void);
+
+void heap_pool_get_class_stats(size_t index, heap_pool_class_stats_t *stats);
+
+/*
+ * Internal fragmentation: bytes reserved in blocks in use but not requested
+ * by the caller (block_size * in_use - requested), summed over all classes.
+ */
+size_t heap_pool_wasted_bytes(void);
+
+#endif /* HEAP_POOL_H */
@@ -0,0 +1,83 @@
+#include "FreeRTOS.h"
+
+#include "hardware/sync.h"
+#include "hardware/timer.h"
+
+#if TRACE_RECORDER_ENABLED
+
+#define TRACE_RECORDER_MAX_NAMES 8
+
+typedef struct {
+    uint8_t kind;
+    uint8_t id;
+    const char *name;
+} trace_name_t;
+
+static trace_record_t trace_ring[TRACE_RECORDER_SIZE];
+static uint32_t trace_head;
+static volatile bool trace_frozen;
+
+static trace_name_t trace_names[TRACE_RECORDER_MAX_NAMES];
+static uint32_t trace_name_count;
+
+void trace_recorder_record(uint8_t type, uint8_t id, uint16_t arg) {
+    if (trace_frozen) {
+        return;
+    }
+
+    // Pode ser chamado de ISR ou de dentro do kernel: so o indice precisa
+    // ser atomico, e desabilitar IRQ no M0+ custa poucos ciclos.
+    uint32_t irq = save_and_disable_interrupts();
+    trace_record_t *r = &trace_ring[trace_head & (TRACE_RECORDER_SIZE - 1)];
+    trace_head++;
+    r->timestamp_us = time_us_32();
+    r->type = type;
+    r->id = id;
+    r->arg = arg;
+    restore_interrupts(irq);
+}
+
+static void trace_recorder_add_name(uint8_t kind, uint8_t id, const char *name) {
+    if (trace_name_count < TRACE_RECORDER_MAX_NAMES) {
+        trace_names[trace_name_count].kind = kind;
+        trace_names[trace_name_count].id = id;
+        trace_names[trace_name_count].name = name;
+        trace_name_count++;
+    }
+}
+
+void trace_recorder_register_isr(uint8_t id, const char *name) {
+    trace_recorder_add_name(TRACE_NAME_ISR, id, name);
+}
+
+uint32_t trace_recorder_freeze(uint32_t *overwritten) {
+    uint32_t irq = save_and_disable_interrupts();
+    trace_frozen = true;
+    restore_interrupts(irq);
+
+    uint32_t count = trace_head < TRACE_RECORDER_SIZE ? trace_head : TRACE_RECORDER_SIZE;
+    *overwritten = trace_head - count;
+    return count;
+}
+
+const trace_record_t *trace_recorder_get(uint32_t index) {
+    uint32_t count = trace_head < TRACE_RECORDER_SIZE ? trace_head : TRACE_RECORDER_SIZE;
+    return &trace_ring[(trace_head - count + index) & (TRACE_RECORDER_SIZE - 1)];
+}
+
+void trace_recorder_resume(void) {
+    trace_head = 0;
+    trace_frozen = false;
+}
+
+bool trace_recorder_get_name(uint32_t index, uint8_t *kind, uint8_t *id, const char **name) {
+    if (index >= trace_name_count) {
+        return false;
+    }
+    *kind = trace_names[index].kind;
+    *id = trace_names[index].id;
+    *name = trace_names[index].name;
+    return true;
+}
+
+#endif /* TRACE_RECORDER_ENABLED */
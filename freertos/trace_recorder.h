@@ -0,0 +1,112 @@
+/*
+ * Kernel trace recorder.
+ *
+ * Included from FreeRTOSConfig.h when TRACE_RECORDER_ENABLED is set: the
+ * FreeRTOS trace macros below write 8-byte records with a microsecond
+ * timestamp into a RAM ring (oldest records are overwritten). The kernel
+ * macros expand inside tasks.c/queue.c, so they read the TCB and queue
+ * fields directly instead of calling accessor functions.
+ *
+ * FreeRTOS V10.4.3 has no ISR enter/exit hooks; application ISRs call
+ * trace_isr_enter()/trace_isr_exit() themselves.
+ */
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TRACE_RECORDER_SIZE 1024 /* registros, potencia de 2 */
+#define TRACE_RECORDER_NAME_LEN 12
+
+typedef enum {
+    TRACE_EVT_TASK_IN = 1,
+    TRACE_EVT_TASK_OUT,
+    TRACE_EVT_QUEUE_SEND,
+    TRACE_EVT_QUEUE_SEND_ISR,
+    TRACE_EVT_QUEUE_RECEIVE,
+    TRACE_EVT_QUEUE_RECEIVE_ISR,
+    TRACE_EVT_QUEUE_BLOCK,
+    TRACE_EVT_NOTIFY,
+    TRACE_EVT_NOTIFY_ISR,
+    TRACE_EVT_NOTIFY_TAKE,
+    TRACE_EVT_ISR_ENTER,
+    TRACE_EVT_ISR_EXIT,
+} trace_event_t;
+
+typedef enum {
+    TRACE_NAME_TASK = 0,
+    TRACE_NAME_QUEUE,
+    TRACE_NAME_ISR,
+} trace_name_kind_t;
+
+typedef struct {
+    uint32_t timestamp_us;
+    uint8_t type; /* trace_event_t */
+    uint8_t id;   /* numero da task, fila ou ISR */
+    uint16_t arg; /* depende do evento (ex.: itens na fila) */
+} trace_record_t;
+
+/* IDs das ISRs da aplicacao */
+#define TRACE_ISR_GPIO 1
+#define TRACE_ISR_SIO_FIFO 2
+#define TRACE_ISR_UART_RX 3
+
+#if TRACE_RECORDER_ENABLED
+
+void trace_recorder_record(uint8_t type, uint8_t id, uint16_t arg);
+
+void trace_recorder_register_isr(uint8_t id, const char *name);
+
+/*
+ * Freezes recording and returns how many records are held. While frozen,
+ * trace_recorder_get(i) returns the i-th oldest record; resume clears the ring.
+ */
+uint32_t trace_recorder_freeze(uint32_t *overwritten);
+const trace_record_t *trace_recorder_get(uint32_t index);
+void trace_recorder_resume(void);
+
+/* Registered names (ISRs); returns false past the last one. */
+bool trace_recorder_get_name(uint32_t index, uint8_t *kind, uint8_t *id, const char **name);
+
+#define trace_isr_enter(id) trace_recorder_record(TRACE_EVT_ISR_ENTER, (id), 0)
+#define trace_isr_exit(id) trace_recorder_record(TRACE_EVT_ISR_EXIT, (id), 0)
+
+#define traceTASK_SWITCHED_IN() \
+    trace_recorder_record(TRACE_EVT_TASK_IN, (uint8_t)pxCurrentTCB->uxTCBNumber, 0)
+#define traceTASK_SWITCHED_OUT() \
+    trace_recorder_record(TRACE_EVT_TASK_OUT, (uint8_t)pxCurrentTCB->uxTCBNumber, 0)
+
+#define traceQUEUE_SEND(pxQueue)                                               \
+    trace_recorder_record(TRACE_EVT_QUEUE_SEND, (uint8_t)(pxQueue)->uxQueueNumber, \
+                          (uint16_t)(pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_SEND_FROM_ISR(pxQueue)                                          \
+    trace_recorder_record(TRACE_EVT_QUEUE_SEND_ISR, (uint8_t)(pxQueue)->uxQueueNumber, \
+                          (uint16_t)(pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_RECEIVE(pxQueue)                                               \
+    trace_recorder_record(TRACE_EVT_QUEUE_RECEIVE, (uint8_t)(pxQueue)->uxQueueNumber, \
+                          (uint16_t)(pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue)                                          \
+    trace_recorder_record(TRACE_EVT_QUEUE_RECEIVE_ISR, (uint8_t)(pxQueue)->uxQueueNumber, \
+                          (uint16_t)(pxQueue)->uxMessagesWaiting)
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue) \
+    trace_recorder_record(TRACE_EVT_QUEUE_BLOCK, (uint8_t)(pxQueue)->uxQueueNumber, 0)
+
+#define traceTASK_NOTIFY(uxIndexToNotify) \
+    trace_recorder_record(TRACE_EVT_NOTIFY, (uint8_t)pxTCB->uxTCBNumber, (uxIndexToNotify))
+#define traceTASK_NOTIFY_FROM_ISR(uxIndexToNotify) \
+    trace_recorder_record(TRACE_EVT_NOTIFY_ISR, (uint8_t)pxTCB->uxTCBNumber, (uxIndexToNotify))
+#define traceTASK_NOTIFY_GIVE_FROM_ISR(uxIndexToNotify) \
+    trace_recorder_record(TRACE_EVT_NOTIFY_ISR, (uint8_t)pxTCB->uxTCBNumber, (uxIndexToNotify))
+#define traceTASK_NOTIFY_TAKE(uxIndexToWait) \
+    trace_recorder_record(TRACE_EVT_NOTIFY_TAKE, (uint8_t)pxCurrentTCB->uxTCBNumber, (uxIndexToWait))
+
+#else
+
+#define trace_isr_enter(id)
+#define trace_isr_exit(id)
+#define trace_recorder_register_isr(id, name)
+
+#endif /* TRACE_RECORDER_ENABLED */
+
+#endif /* TRACE_RECORDER_H */
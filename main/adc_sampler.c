@@ -0,0 +1,86 @@
+#include "adc_sampler.h"
+
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+#define ADC_CLOCK_HZ 48000000
+#define ADC_SAMPLER_TOTAL_HZ (ADC_SAMPLER_RATE_HZ * ADC_SAMPLER_CHANNELS)
+
+// Alinhado ao tamanho para o wrap de endereco do DMA
+static uint16_t adc_ring[ADC_SAMPLER_RING_LEN] __attribute__((aligned(1u << ADC_SAMPLER_RING_BITS)));
+
+static int adc_dma = -1;
+static volatile uint32_t start_time_us; // instante da primeira conversao
+
+static void adc_sampler_start(void) {
+    adc_run(false);
+    adc_fifo_drain();
+    // Round-robin recomeca do canal 0: a posicao 0 sempre e o canal 0
+    adc_select_input(0);
+
+    dma_channel_config cfg = dma_channel_get_default_config(adc_dma);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&cfg, false);
+    channel_config_set_write_increment(&cfg, true);
+    channel_config_set_ring(&cfg, true, ADC_SAMPLER_RING_BITS);
+    channel_config_set_dreq(&cfg, DREQ_ADC);
+    // ~8 dias a 2 kHz x 3 canais ate precisar reiniciar
+    dma_channel_configure(adc_dma, &cfg, adc_ring, &adc_hw->fifo, UINT32_MAX, true);
+
+    start_time_us = time_us_32() + 1000000 / ADC_SAMPLER_TOTAL_HZ;
+    adc_run(true);
+}
+
+// Fim da contagem do DMA: reinicia do zero (leitores veem a posicao voltar)
+static void adc_sampler_dma_isr(void) {
+    if (dma_channel_get_irq1_status(adc_dma)) {
+        dma_channel_acknowledge_irq1(adc_dma);
+        adc_sampler_start();
+    }
+}
+
+void adc_sampler_init(void) {
+    adc_init();
+    for (uint ch = 0; ch < ADC_SAMPLER_CHANNELS; ch++) {
+        adc_gpio_init(26 + ch);
+    }
+
+    adc_set_round_robin((1u << ADC_SAMPLER_CHANNELS) - 1);
+    // FIFO com DREQ a cada amostra, sem bit de erro e sem shift para 8 bits
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_set_clkdiv((float)ADC_CLOCK_HZ / ADC_SAMPLER_TOTAL_HZ - 1);
+
+    adc_dma = dma_claim_unused_channel(true);
+    dma_channel_set_irq1_enabled(adc_dma, true);
+    irq_add_shared_handler(DMA_IRQ_1, adc_sampler_dma_isr, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+
+    adc_sampler_start();
+}
+
+uint32_t adc_sampler_position(void) {
+    return UINT32_MAX - dma_channel_hw_addr(adc_dma)->transfer_count;
+}
+
+uint16_t adc_sampler_at(uint32_t pos) {
+    return adc_ring[pos % ADC_SAMPLER_RING_LEN];
+}
+
+uint32_t adc_sampler_time_us(uint32_t pos) {
+    return start_time_us + (uint32_t)((uint64_t)pos * 1000000 / ADC_SAMPLER_TOTAL_HZ);
+}
+
+uint16_t adc_sampler_latest(uint channel) {
+    uint32_t pos = adc_sampler_position();
+    if (pos <= channel) {
+        return 0; // canal ainda nao convertido
+    }
+
+    // Ultima posicao < pos cujo canal e `channel`
+    uint32_t last = pos - 1;
+    last -= (last + ADC_SAMPLER_CHANNELS - channel) % ADC_SAMPLER_CHANNELS;
+    return adc_sampler_at(last);
+}
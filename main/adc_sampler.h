@@ -0,0 +1,46 @@
+#ifndef ADC_SAMPLER_H_
+#define ADC_SAMPLER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "pico/stdlib.h"
+
+/*
+ * ADC em modo livre (round-robin) com DMA para um ring em RAM.
+ *
+ * O ADC converte os canais habilitados em sequencia, sem CPU, a
+ * ADC_SAMPLER_RATE_HZ por canal; o DMA copia cada resultado para um ring
+ * circular alinhado (wrap feito pelo proprio DMA). Quem le so consulta o
+ * ring: joystick pega o valor mais recente e o detector de palhetada
+ * processa todas as amostras novas com o instante exato de cada uma.
+ *
+ * Posicoes sao contadores absolutos de conversoes; a amostra da posicao
+ * p e do canal (p % numero de canais). Seguro de ler dos dois cores.
+ */
+
+#define ADC_SAMPLER_CHANNELS 3       // ADC0 (X), ADC1 (Y / palhetada), ADC2 (whammy)
+#define ADC_SAMPLER_RATE_HZ 2000     // por canal
+#define ADC_SAMPLER_RING_BITS 10     // 2^10 bytes = 512 amostras de 16 bits
+#define ADC_SAMPLER_RING_LEN ((1u << ADC_SAMPLER_RING_BITS) / sizeof(uint16_t))
+
+void adc_sampler_init(void);
+
+// Numero de conversoes ja escritas no ring
+uint32_t adc_sampler_position(void);
+
+// Amostra da posicao pos; valida enquanto pos > position - RING_LEN
+uint16_t adc_sampler_at(uint32_t pos);
+
+// Canal da conversao na posicao pos
+static inline uint adc_sampler_channel_of(uint32_t pos) {
+    return pos % ADC_SAMPLER_CHANNELS;
+}
+
+// Instante (time_us_32) em que a conversao pos terminou
+uint32_t adc_sampler_time_us(uint32_t pos);
+
+// Ultima conversao completa do canal
+uint16_t adc_sampler_latest(uint channel);
+
+#endif // ADC_SAMPLER_H_
@@ -0,0 +1,109 @@
+#include "app_signals.h"
+
+#include "pico/stdlib.h"
+
+#include <string.h>
+
+#include "rtos_static.h"
+#include "spsc_ring.h"
+
+static TaskHandle_t radio_task;
+static EventGroupHandle_t link_events;
+
+// Ultimo valor de cada eixo; int de 32 bits e escrito/lido atomicamente
+static volatile int axis_value[SIGNAL_AXIS_COUNT];
+static volatile uint32_t axis_time_us[SIGNAL_AXIS_COUNT];
+static volatile uint32_t isr_time_us;
+
+static app_text_t text_ring_buf[APP_SIGNALS_TEXT_RING_SIZE];
+static spsc_ring_t text_ring;
+static volatile uint32_t text_overflows;
+
+RTOS_STATIC_EVENT_GROUP(link);
+
+void app_signals_init(void) {
+    link_events = RTOS_EVENT_GROUP_CREATE(link);
+    configASSERT(link_events);
+    spsc_ring_init(&text_ring, APP_SIGNALS_TEXT_RING_SIZE);
+}
+
+void app_signals_set_radio_task(TaskHandle_t task) {
+    radio_task = task;
+}
+
+void app_signals_publish_axis(int axis, int val) {
+    axis_value[axis] = val;
+    axis_time_us[axis] = time_us_32();
+
+    // Antes do radio subir o valor so fica no slot
+    if (radio_task != NULL) {
+        xTaskNotifyIndexed(radio_task, SIGNAL_NOTIFY_INDEX, SIGNAL_AXIS(axis), eSetBits);
+    }
+}
+
+int app_signals_axis_value(int axis) {
+    return axis_value[axis];
+}
+
+uint32_t app_signals_axis_time(int axis) {
+    return axis_time_us[axis];
+}
+
+void app_signals_notify_from_isr(uint32_t bits) {
+    BaseType_t woken = pdFALSE;
+
+    isr_time_us = time_us_32();
+    if (radio_task != NULL) {
+        xTaskNotifyIndexedFromISR(radio_task, SIGNAL_NOTIFY_INDEX, bits, eSetBits, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
+}
+
+uint32_t app_signals_wait(TickType_t timeout) {
+    uint32_t bits = 0;
+
+    xTaskNotifyWaitIndexed(SIGNAL_NOTIFY_INDEX, 0, UINT32_MAX, &bits, timeout);
+    return bits;
+}
+
+uint32_t app_signals_isr_time(void) {
+    return isr_time_us;
+}
+
+bool app_signals_send_text(const char *text, uint32_t event_us) {
+    if (spsc_ring_full(&text_ring)) {
+        text_overflows++;
+        return false;
+    }
+    app_text_t *slot = &text_ring_buf[spsc_ring_head_slot(&text_ring)];
+    strncpy(slot->text, text, APP_SIGNALS_TEXT_LEN - 1);
+    slot->text[APP_SIGNALS_TEXT_LEN - 1] = '\0';
+    slot->event_us = event_us;
+    spsc_ring_publish(&text_ring);
+
+    if (radio_task != NULL) {
+        xTaskNotifyIndexed(radio_task, SIGNAL_NOTIFY_INDEX, SIGNAL_TEXT, eSetBits);
+    }
+    return true;
+}
+
+bool app_signals_pop_text(app_text_t *out) {
+    if (spsc_ring_empty(&text_ring)) {
+        return false;
+    }
+    *out = text_ring_buf[spsc_ring_tail_slot(&text_ring)];
+    spsc_ring_release(&text_ring);
+    return true;
+}
+
+uint32_t app_signals_text_overflows(void) {
+    return text_overflows;
+}
+
+const spsc_ring_t *app_signals_text_ring(void) {
+    return &text_ring;
+}
+
+EventGroupHandle_t app_signals_link_events(void) {
+    return link_events;
+}
@@ -0,0 +1,76 @@
+#ifndef APP_SIGNALS_H_
+#define APP_SIGNALS_H_
+
+#include <FreeRTOS.h>
+#include <task.h>
+#include <event_groups.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "spsc_ring.h"
+
+/*
+ * Sinalizacao entre tasks sem objetos de fila/semaforo no caminho quente.
+ *
+ * Produtores de eixo (joystick, acelerometro) escrevem o ultimo valor num
+ * slot por eixo e setam o bit correspondente na notificacao da task do
+ * radio; o radio le o slot direto (uma unica copia do dado). O estado de
+ * conexao (bluetooth/USB) fica num event group que qualquer task consulta.
+ *
+ * O radio e o unico escritor da UART do HC-06: texto de botoes e palhetada
+ * chega por um ring SPSC e sai inteiro entre os relatorios de eixo.
+ */
+
+// Indice do array de notificacoes usado aqui. O indice 0 fica com
+// ulTaskNotifyTake (doorbell do core 1) e com stream/message buffers.
+#define SIGNAL_NOTIFY_INDEX 1
+
+// Bits de notificacao da task do radio
+#define SIGNAL_AXIS_COUNT 4
+#define SIGNAL_AXIS(axis) (1u << (axis)) // 0 = X, 1 = Y, 2 = acelerometro, 3 = whammy
+#define SIGNAL_AXIS_MASK  ((1u << SIGNAL_AXIS_COUNT) - 1)
+#define SIGNAL_UART_RX    (1u << 8)
+#define SIGNAL_TEXT       (1u << 9)
+
+#define APP_SIGNALS_TEXT_LEN 24       // cabe "DOWN:DOWN\nDOWN:UP\n"
+#define APP_SIGNALS_TEXT_RING_SIZE 16 // potencia de 2
+
+typedef struct {
+    char text[APP_SIGNALS_TEXT_LEN];
+    uint32_t event_us; // instante do evento que gerou o texto
+} app_text_t;
+
+// Bits do event group de estado de conexao
+#define LINK_BT_CONNECTED (1u << 0) // HC-06 recebeu algo do host
+#define LINK_USB_HOST     (1u << 1) // terminal aberto na USB CDC
+
+void app_signals_init(void);
+
+// Chamado pela task do radio antes de esperar sinais
+void app_signals_set_radio_task(TaskHandle_t task);
+
+// Publica o ultimo valor de um eixo e acorda o radio
+void app_signals_publish_axis(int axis, int val);
+int app_signals_axis_value(int axis);
+// Instante (time_us_32) da ultima publicacao do eixo, para o deadline do radio
+uint32_t app_signals_axis_time(int axis);
+
+void app_signals_notify_from_isr(uint32_t bits);
+// Instante da ultima notificacao vinda de ISR
+uint32_t app_signals_isr_time(void);
+
+// Produtor unico (task dos botoes): enfileira o texto e acorda o radio.
+// Retorna false com o ring cheio (texto descartado e contado).
+bool app_signals_send_text(const char *text, uint32_t event_us);
+// Radio: retorna false quando nao ha texto pendente
+bool app_signals_pop_text(app_text_t *out);
+uint32_t app_signals_text_overflows(void);
+const spsc_ring_t *app_signals_text_ring(void);
+
+// Bloqueia a task do radio ate algum sinal; retorna os bits (ja limpos)
+uint32_t app_signals_wait(TickType_t timeout);
+
+EventGroupHandle_t app_signals_link_events(void);
+
+#endif // APP_SIGNALS_H_
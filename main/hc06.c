@@ -53,29 +53,22 @@ bool hc06_set_at_mode(int on){
     gpio_put(HC06_ENABLE_PIN, on);
 }
 
+// Sem printf: a USB CDC carrega os frames binarios do usb_link, e texto
+// solto no meio de um frame quebra o CRC
 bool hc06_init(char name[], char pin[]) {
     hc06_set_at_mode(1);
-    printf("check connection\n");
     while (hc06_check_connection() == false) {
-        printf("not connected\n");
         vTaskDelay(pdMS_TO_TICKS(1000));
     }
-    printf("Connected \n");
 
     vTaskDelay(pdMS_TO_TICKS(1000));
-    printf("set name\n");
     while (hc06_set_name(name) == false) {
-        printf("set name failed\n");
         vTaskDelay(pdMS_TO_TICKS(1000));
     }
-    printf("name ok\n");
 
     vTaskDelay(pdMS_TO_TICKS(1000));
-    printf("set pin\n");
     while (hc06_set_pin(pin) == false) {
-        printf("set pin failed\n");
         vTaskDelay(pdMS_TO_TICKS(1000));
     }
-    printf("pin ok\n");
     hc06_set_at_mode(0);
 }
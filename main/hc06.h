@@ -18,6 +18,9 @@
 #define HC06_TX_PIN 5
 #define HC06_ENABLE_PIN 6
 
+// Comandos do host recebidos pelo bluetooth
+#define HC06_CMD_RUMBLE 'V' // seguido de 1 byte com o rumble_fx_t
+
 bool hc06_check_connection();
 bool hc06_set_name(char name[]);
 bool hc06_set_pin(char pin[]);
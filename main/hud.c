@@ -0,0 +1,138 @@
+#include "hud.h"
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <stdio.h>
+
+#include "pico/stdlib.h"
+
+#include "gfx.h"
+#include "ssd1306.h"
+
+#include "app_signals.h"
+#include "rt_monitor.h"
+#include "task_config.h"
+
+static volatile uint32_t hud_reports;    // relatorios enviados ao host
+static volatile int32_t hud_tilt_cdeg;   // ultimo angulo, centesimos de grau
+
+void hud_note_report(void) { hud_reports++; }
+
+void hud_note_tilt(float angle_deg) { hud_tilt_cdeg = (int32_t)(angle_deg * 100); }
+
+// Soma dos deadlines perdidos pelas outras tasks
+static uint32_t hud_total_misses(void) {
+    uint32_t misses = 0;
+    for (int id = 0; id < TASK_ID_COUNT; id++) {
+        if (id != TASK_ID_HUD) {
+            misses += rt_monitor_get((task_id_t)id)->misses;
+        }
+    }
+    return misses;
+}
+
+// Fim do flush (IRQ do DMA): acorda a task, que fica bloqueada em vez de
+// girar em ssd1306_dma_wait() dentro do proximo gfx_show
+static void hud_flush_done(void *arg) {
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR((TaskHandle_t)arg, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+// Retorna true se um flush foi iniciado (o aviso vem por hud_flush_done)
+static bool hud_render(ssd1306_t *disp, uint32_t rate, uint32_t cpu_pct, uint32_t skipped) {
+    EventBits_t link = xEventGroupGetBits(app_signals_link_events());
+    const rt_task_stats_t *btn = rt_monitor_get(TASK_ID_BUTTON);
+    int32_t tilt = hud_tilt_cdeg / 100;
+    char line[24];
+
+    gfx_clear_buffer(disp);
+
+    snprintf(line, sizeof(line), "BT %s USB %s %lu/s",
+             (link & LINK_BT_CONNECTED) ? "ON" : "--",
+             (link & LINK_USB_HOST) ? "ON" : "--", (unsigned long)rate);
+    gfx_draw_string(disp, 0, 0, 1, line);
+
+    snprintf(line, sizeof(line), "LAT %lu MAX %luus",
+             (unsigned long)btn->last_response_us,
+             (unsigned long)btn->worst_response_us);
+    gfx_draw_string(disp, 0, 8, 1, line);
+
+    snprintf(line, sizeof(line), "CPU %lu%% SKIP %lu", (unsigned long)cpu_pct,
+             (unsigned long)skipped);
+    gfx_draw_string(disp, 0, 16, 1, line);
+
+    // Angulo em texto + barra (90 graus = resto da linha)
+    snprintf(line, sizeof(line), "TILT %ld", (long)tilt);
+    gfx_draw_string(disp, 0, 24, 1, line);
+    if (tilt < 0) {
+        tilt = -tilt;
+    }
+    if (tilt > 90) {
+        tilt = 90;
+    }
+    gfx_draw_hline(disp, 54, 127, 25);
+    gfx_draw_hline(disp, 54, 127, 31);
+    gfx_draw_vline(disp, 54, 25, 31);
+    gfx_draw_vline(disp, 127, 25, 31);
+    gfx_fill_rect(disp, 56, 27, tilt * 70 / 90, 3);
+
+    return gfx_show(disp);
+}
+
+void hud_task(void *p) {
+    ssd1306_t disp;
+    ssd1306_init();
+    gfx_init(&disp, GFX_MONO_LCD_WIDTH, GFX_MONO_LCD_HEIGHT);
+    ssd1306_dma_set_done_callback(hud_flush_done, xTaskGetCurrentTaskHandle());
+
+    uint32_t rate = 0, cpu_pct = 0, skipped = 0;
+    bool flushing = false;
+    uint32_t misses = hud_total_misses();
+    uint32_t window_start = time_us_32();
+    uint32_t window_reports = hud_reports;
+    uint32_t window_idle = ulTaskGetIdleRunTimeCounter();
+
+    TickType_t last_wake = xTaskGetTickCount();
+    while (true) {
+        // pdFALSE: o periodo ja tinha passado, ou seja, estamos atrasados
+        BaseType_t on_time = xTaskDelayUntil(&last_wake, pdMS_TO_TICKS(HUD_FRAME_MS));
+        rt_monitor_release(TASK_ID_HUD);
+
+        uint32_t now = time_us_32();
+        uint32_t elapsed = now - window_start;
+        if (elapsed >= HUD_RATE_WINDOW_MS * 1000u) {
+            uint32_t reports = hud_reports;
+            uint32_t idle = ulTaskGetIdleRunTimeCounter();
+            uint32_t idle_us = idle - window_idle;
+
+            rate = (uint32_t)(((uint64_t)(reports - window_reports) * 1000000u) / elapsed);
+            cpu_pct = idle_us >= elapsed ? 0 : 100 - (uint32_t)(((uint64_t)idle_us * 100) / elapsed);
+
+            window_start = now;
+            window_reports = reports;
+            window_idle = idle;
+        }
+
+        uint32_t total_misses = hud_total_misses();
+        bool late = on_time == pdFALSE || total_misses != misses;
+        misses = total_misses;
+
+        // Flush anterior ainda sem aviso de fim: so consome a notificacao,
+        // sem consultar o DMA
+        if (flushing && ulTaskNotifyTake(pdTRUE, 0) != 0) {
+            flushing = false;
+        }
+
+        if (late || flushing) {
+            skipped++;
+        } else if (hud_render(&disp, rate, cpu_pct, skipped)) {
+            // Espera o fim do envio; o buffer de tras ja pode ser desenhado,
+            // mas o proximo gfx_show nao pode encontrar o DMA ocupado
+            flushing = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(HUD_FRAME_MS)) == 0;
+        }
+
+        rt_monitor_complete(TASK_ID_HUD);
+    }
+}
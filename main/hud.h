@@ -0,0 +1,24 @@
+#ifndef HUD_H_
+#define HUD_H_
+
+/*
+ * HUD no OLED (SSD1306 na SPI1) com contadores de desempenho ao vivo:
+ * conexao, taxa de relatorios, latencia botao -> radio, carga de CPU e
+ * angulo de inclinacao.
+ *
+ * Roda na prioridade de fundo a HUD_FRAME_MS por quadro. O quadro e
+ * pulado (so conta) quando a propria task acordou atrasada, quando alguma
+ * task perdeu deadline desde o quadro anterior ou quando o DMA do quadro
+ * anterior ainda nao terminou; assim o display nunca disputa tempo com o
+ * caminho de entrada.
+ */
+#define HUD_FRAME_MS 100
+#define HUD_RATE_WINDOW_MS 1000 // janela da taxa de relatorios e da CPU
+
+// Chamados pelas outras tasks; so escrevem um contador/valor
+void hud_note_report(void);
+void hud_note_tilt(float angle_deg);
+
+void hud_task(void *p);
+
+#endif // HUD_H_
@@ -0,0 +1,127 @@
+#include "led_engine.h"
+
+#include <FreeRTOS.h>
+#include <task.h>
+#include <timers.h>
+
+#include "pico/stdlib.h"
+#include "hardware/pwm.h"
+
+#include "app_signals.h"
+#include "rtos_static.h"
+
+#define BLINK_CODE_PERIOD_MS 2000
+#define BLINK_ON_MS 150
+#define BLINK_GAP_MS 200
+
+typedef struct {
+    uint gpio;
+    uint8_t pattern;
+    uint8_t arg;
+    uint8_t overlay_pattern;
+    uint8_t overlay_arg;
+    uint16_t overlay_ticks; // ticks restantes do overlay (0 = sem overlay)
+} led_state_t;
+
+static led_state_t leds[LED_COUNT] = {
+    [LED_RED] = {.gpio = LED_RED_PIN},
+    [LED_GREEN] = {.gpio = LED_GREEN_PIN},
+};
+
+static uint32_t tick;
+
+RTOS_STATIC_TIMER(led_engine);
+
+// Correcao de brilho aproximada (gamma 2): 0..255 -> 0..65025
+static void led_write(const led_state_t *led, uint8_t level) {
+    pwm_set_gpio_level(led->gpio, (uint16_t)level * level);
+}
+
+static uint8_t led_pattern_level(uint8_t pattern, uint8_t arg) {
+    uint32_t t_ms = tick * LED_ENGINE_TICK_MS;
+
+    switch (pattern) {
+    case LED_PATTERN_ON:
+        return arg;
+    case LED_PATTERN_BREATHE: {
+        uint32_t period = (arg ? arg : 20) * 100;
+        uint32_t phase = t_ms % period;
+        uint32_t half = period / 2;
+        // Triangulo; a curva vem da correcao de gamma
+        return (phase < half ? phase : period - phase) * 255 / half;
+    }
+    case LED_PATTERN_BLINK_CODE: {
+        uint32_t phase = t_ms % BLINK_CODE_PERIOD_MS;
+        uint32_t slot = phase / (BLINK_ON_MS + BLINK_GAP_MS);
+        if (slot >= arg) {
+            return 0;
+        }
+        return (phase % (BLINK_ON_MS + BLINK_GAP_MS)) < BLINK_ON_MS ? 255 : 0;
+    }
+    case LED_PATTERN_PULSE:
+        return ((tick / (arg ? arg : 1)) & 1) ? 0 : 255;
+    default:
+        return 0;
+    }
+}
+
+// Padrao base de cada LED a partir do estado de conexao
+static void led_apply_link_state(EventBits_t link) {
+    if (link & LINK_BT_CONNECTED) {
+        leds[LED_RED].pattern = LED_PATTERN_OFF;
+        leds[LED_GREEN].pattern = LED_PATTERN_BREATHE;
+        leds[LED_GREEN].arg = 30;
+    } else {
+        // 1 piscada: esperando bluetooth; 2: so a USB esta conectada
+        leds[LED_RED].pattern = LED_PATTERN_BLINK_CODE;
+        leds[LED_RED].arg = (link & LINK_USB_HOST) ? 2 : 1;
+        leds[LED_GREEN].pattern = LED_PATTERN_OFF;
+    }
+}
+
+static void led_engine_callback(TimerHandle_t timer) {
+    (void)timer;
+    tick++;
+
+    led_apply_link_state(xEventGroupGetBits(app_signals_link_events()));
+
+    taskENTER_CRITICAL();
+    for (int i = 0; i < LED_COUNT; i++) {
+        led_state_t *led = &leds[i];
+        uint8_t level;
+
+        if (led->overlay_ticks > 0) {
+            led->overlay_ticks--;
+            level = led_pattern_level(led->overlay_pattern, led->overlay_arg);
+        } else {
+            level = led_pattern_level(led->pattern, led->arg);
+        }
+        led_write(led, level);
+    }
+    taskEXIT_CRITICAL();
+}
+
+void led_engine_init(void) {
+    for (int i = 0; i < LED_COUNT; i++) {
+        uint gpio = leds[i].gpio;
+        uint slice = pwm_gpio_to_slice_num(gpio);
+        pwm_config config = pwm_get_default_config(); // wrap 65535, ~1.9 kHz
+
+        gpio_set_function(gpio, GPIO_FUNC_PWM);
+        pwm_init(slice, &config, true);
+        led_write(&leds[i], 0);
+    }
+
+    TimerHandle_t timer = RTOS_TIMER_CREATE(led_engine, "LED Engine", pdMS_TO_TICKS(LED_ENGINE_TICK_MS),
+                                            pdTRUE, NULL, led_engine_callback);
+    configASSERT(timer);
+    xTimerStart(timer, 0);
+}
+
+void led_engine_overlay(led_id_t led, led_pattern_t pattern, uint8_t arg, uint16_t duration_ms) {
+    taskENTER_CRITICAL();
+    leds[led].overlay_pattern = pattern;
+    leds[led].overlay_arg = arg;
+    leds[led].overlay_ticks = (duration_ms + LED_ENGINE_TICK_MS - 1) / LED_ENGINE_TICK_MS;
+    taskEXIT_CRITICAL();
+}
@@ -0,0 +1,40 @@
+#ifndef LED_ENGINE_H_
+#define LED_ENGINE_H_
+
+#include <stdint.h>
+
+/*
+ * LEDs de status no PWM de hardware.
+ *
+ * Um timer do FreeRTOS de baixa prioridade avanca os padroes a cada
+ * LED_ENGINE_TICK_MS. O padrao base de cada LED vem do estado de conexao
+ * (event group de app_signals), entao o radio e as tasks de entrada nao
+ * mexem em LED; eventos pontuais (star power) entram como overlay
+ * temporario por cima do padrao base.
+ */
+
+#define LED_RED_PIN 3    // GPIO para o LED vermelho (28 e o ADC2 do whammy)
+#define LED_GREEN_PIN 17 // GPIO para o LED verde
+
+#define LED_ENGINE_TICK_MS 20
+
+typedef enum {
+    LED_RED = 0,
+    LED_GREEN,
+    LED_COUNT
+} led_id_t;
+
+typedef enum {
+    LED_PATTERN_OFF = 0,
+    LED_PATTERN_ON,         // arg = brilho (0..255)
+    LED_PATTERN_BREATHE,    // arg = periodo em unidades de 100 ms
+    LED_PATTERN_BLINK_CODE, // arg = numero de piscadas por ciclo de 2 s
+    LED_PATTERN_PULSE,      // arg = meio periodo em unidades de tick
+} led_pattern_t;
+
+void led_engine_init(void);
+
+// Troca o padrao por duration_ms e depois volta ao padrao do estado de conexao
+void led_engine_overlay(led_id_t led, led_pattern_t pattern, uint8_t arg, uint16_t duration_ms);
+
+#endif // LED_ENGINE_H_
@@ -9,14 +9,35 @@
 #include "pico/stdlib.h"
 #include "hardware/adc.h"
 #include "hardware/uart.h"
+#include "hardware/irq.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include "hardware/i2c.h"
 #include "mpu6050.h"
 #include "Fusion.h"
 #include "hc06.h"
-
-#define SAMPLE_PERIOD (0.01f)
+#include "task_config.h"
+#include "rt_monitor.h"
+#include "rtos_stats.h"
+#include "usb_link.h"
+#include "trace_recorder.h"
+#include "rtos_static.h"
+#include "app_signals.h"
+#include "spsc_ring.h"
+#include "rumble.h"
+#include "led_engine.h"
+#include "tilt_detector.h"
+#include "adc_sampler.h"
+#include "strum.h"
+#include "whammy.h"
+#include "hud.h"
+#include "sample_clock.h"
+#if SENSOR_PIPELINE_CORE1
+#include "sensor_core1.h"
+#endif
+
+#define JOYSTICK_PERIOD_MS 10
+#define MPU6050_PERIOD_MS 100
 // UART configuration
 #define UART_ID HC06_UART_ID
 #define BAUD_RATE 115200
@@ -29,45 +50,40 @@ const int BTN_VERMELHO = 19;
 const int BTN_VERDE = 18;
 const int BTN_JOYSTICK = 16; // Joystick button
 
-// Pins for joystick X and Y axes
+// Pins for joystick X and Y axes (Y e a barra de palhetada, ver strum.h)
 const int X_AXIS_PIN = 26;       
 const int Y_AXIS_PIN = 27;
 
-// MPU6050 I2C address
-const int MPU_ADDRESS = 0x68;
-const int I2C_SDA_GPIO = 8;
-const int I2C_SCL_GPIO = 9;
-
-#define LED_RED_PIN 28      // GPIO para o LED vermelho
-#define LED_GREEN_PIN 17    // GPIO para o LED verde
 
 
 
 
-// ADC data structure
-typedef struct adc {
-    int axis;               
-    int val;                
-} adc_t;
+// Eixos enviados ao host (indice do slot em app_signals)
+#define AXIS_X     0
+#define AXIS_Y     1
+#define AXIS_ACCEL 2
+#define AXIS_WHAMMY 3
 
 typedef struct {
     uint gpio_pin;
     bool pressed;
+    uint32_t timestamp_us; // instante da borda, para medir latencia botao -> radio
 } button_event_t;
 
-// Queue for ADC values
-QueueHandle_t xQueueADC;
-QueueHandle_t xQueueButtonEvents;
-SemaphoreHandle_t xSemaphoreEvent;
-SemaphoreHandle_t conexao_semaphore;
+// Eventos dos botoes: ISR -> task_button_serial sem fila do kernel
+#define BUTTON_RING_SIZE 32 // potencia de 2
+static button_event_t button_ring_buf[BUTTON_RING_SIZE];
+static spsc_ring_t button_ring;
+static TaskHandle_t button_task_handle;
+static volatile uint32_t button_ring_overflows; // eventos descartados com o ring cheio
+
+static uint32_t button_overflows(void) { return button_ring_overflows; }
 volatile uint32_t last_bluetooth_message_time = 0;
+sample_clock_t imu_clock; // dt real do IMU e jitter (ver sample_clock.h)
 
 void init_leds() {
-    gpio_init(LED_RED_PIN);
-    gpio_set_dir(LED_RED_PIN, GPIO_OUT);
-
-    gpio_init(LED_GREEN_PIN);
-    gpio_set_dir(LED_GREEN_PIN, GPIO_OUT);
+    // LEDs de status ficam no PWM, controlados pelo led_engine
+    led_engine_init();
 
     gpio_init(HC06_STATE_PIN);
     gpio_set_dir(HC06_STATE_PIN, GPIO_IN);
@@ -78,13 +94,27 @@ void init_leds() {
 // Button interrupt callback
 void btn_note_callback(uint gpio, uint32_t events)
 {
-    button_event_t event;
+    trace_isr_enter(TRACE_ISR_GPIO);
 
-    event.gpio_pin = gpio;
-    event.pressed = (events & GPIO_IRQ_EDGE_FALL) != 0;
+    if (spsc_ring_full(&button_ring)) {
+        button_ring_overflows++;
+        trace_isr_exit(TRACE_ISR_GPIO);
+        return;
+    }
 
-    xQueueSendFromISR(xQueueButtonEvents, &event, 0);
+    button_event_t *event = &button_ring_buf[spsc_ring_head_slot(&button_ring)];
+    event->gpio_pin = gpio;
+    event->pressed = (events & GPIO_IRQ_EDGE_FALL) != 0;
+    event->timestamp_us = time_us_32();
+    spsc_ring_publish(&button_ring);
 
+    // Uma notificacao por evento; a task so bloqueia com o ring vazio
+    BaseType_t woken = pdFALSE;
+    if (button_task_handle != NULL) {
+        vTaskNotifyGiveFromISR(button_task_handle, &woken);
+    }
+    trace_isr_exit(TRACE_ISR_GPIO);
+    portYIELD_FROM_ISR(woken);
 }
 
 // Initialize all buttons
@@ -141,57 +171,11 @@ int convert_adc_value(uint16_t adc_val) {
     return scaled_value;
 }
 
-// MPU
-static void mpu6050_reset() {
-    // Two byte reset. First byte register, second byte data
-    // There are a load more options to set up the device in different ways that could be added here
-    uint8_t buf[] = {0x6B, 0x00};
-    i2c_write_blocking(i2c_default, MPU_ADDRESS, buf, 2, false);
-}
-
-static void mpu6050_read_raw(int16_t accel[3], int16_t gyro[3], int16_t *temp) {
-    // For this particular device, we send the device the register we want to read
-    // first, then subsequently read from the device. The register is auto incrementing
-    // so we don't need to keep sending the register we want, just the first.
-
-    uint8_t buffer[6];
-
-    // Start reading acceleration registers from register 0x3B for 6 bytes
-    uint8_t val = 0x3B;
-    i2c_write_blocking(i2c_default, MPU_ADDRESS, &val, 1, true); // true to keep master control of bus
-    i2c_read_blocking(i2c_default, MPU_ADDRESS, buffer, 6, false);
-
-    for (int i = 0; i < 3; i++) {
-        accel[i] = (buffer[i * 2] << 8 | buffer[(i * 2) + 1]);
-    }
-
-    // Now gyro data from reg 0x43 for 6 bytes
-    // The register is auto incrementing on each read
-    val = 0x43;
-    i2c_write_blocking(i2c_default, MPU_ADDRESS, &val, 1, true);
-    i2c_read_blocking(i2c_default, MPU_ADDRESS, buffer, 6, false);  // False - finished with bus
-
-    for (int i = 0; i < 3; i++) {
-        gyro[i] = (buffer[i * 2] << 8 | buffer[(i * 2) + 1]);;
-    }
-
-    // Now temperature from reg 0x41 for 2 bytes
-    // The register is auto incrementing on each read
-    val = 0x41;
-    i2c_write_blocking(i2c_default, MPU_ADDRESS, &val, 1, true);
-    i2c_read_blocking(i2c_default, MPU_ADDRESS, buffer, 2, false);  // False - finished with bus
-
-    *temp = buffer[0] << 8 | buffer[1];
-}
-
-void hc06_send_text(const char* text) {
-    size_t len = strlen(text);
-    for (size_t i = 0; i < len; i++) {
-        while (!uart_is_writable(HC06_UART_ID)) {
-            taskYIELD(); // Deixa o FreeRTOS trocar de task enquanto espera
-        }
-        uart_putc_raw(HC06_UART_ID, text[i]);
-    }
+// Vibracao + pulso nos dois LEDs ao ativar o star power
+static void star_power_feedback(void) {
+    rumble_play(RUMBLE_FX_STAR_POWER);
+    led_engine_overlay(LED_RED, LED_PATTERN_PULSE, 3, 750);
+    led_engine_overlay(LED_GREEN, LED_PATTERN_PULSE, 3, 750);
 }
 
 // Task to monitor button status and send via serial printf
@@ -202,17 +186,39 @@ void task_button_serial(void *p) {
 
     button_event_t event;
 
+    button_task_handle = xTaskGetCurrentTaskHandle();
+#if STRUM_BAR_ENABLED
+    strum_event_t strum_event;
+    strum_start(button_task_handle);
+#endif
+
     while (true) {
-        if (xQueueReceive(xQueueButtonEvents, &event, portMAX_DELAY)) {
+        // Esvazia antes de bloquear: eventos anteriores ao handle nao notificam
+        while (!spsc_ring_empty(&button_ring)) {
+            event = button_ring_buf[spsc_ring_tail_slot(&button_ring)];
+            spsc_ring_release(&button_ring);
+
             for (int i = 0; i < 6; i++) {
                 if (event.gpio_pin == gpios[i]) {
                     char buffer[16];
                     snprintf(buffer, sizeof(buffer), "%s:%s\n", letras[i], event.pressed ? "DOWN" : "UP");
-                    hc06_send_text(buffer);
+                    app_signals_send_text(buffer, event.timestamp_us);
                     break;
                 }
             }
+            rt_monitor_event_complete(TASK_ID_BUTTON, event.timestamp_us);
+        }
+
+#if STRUM_BAR_ENABLED
+        // Palhetada vira um toque na seta correspondente (cima/baixo)
+        while (strum_pop(&strum_event)) {
+            app_signals_send_text(strum_event.direction == STRUM_DOWN ? "DOWN:DOWN\nDOWN:UP\n" : "UP:DOWN\nUP:UP\n",
+                                  strum_event.timestamp_us);
+            rt_monitor_event_complete(TASK_ID_BUTTON, strum_event.timestamp_us);
         }
+#endif
+
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
 }
 
@@ -221,12 +227,11 @@ void x_task(void *p) {
     uint16_t x_values[5] = {0};
     int x_index = 0;
     
-    adc_t adc_data;
-    adc_data.axis = 0; // X axis
-    
+    TickType_t last_wake = xTaskGetTickCount();
     while (1) {
-        adc_select_input(0);
-        x_values[x_index] = adc_read();
+        rt_monitor_release(TASK_ID_X_AXIS);
+
+        x_values[x_index] = adc_sampler_latest(0);
         x_index = (x_index + 1) % 5;
         
         // Simple moving average filter
@@ -236,28 +241,28 @@ void x_task(void *p) {
         }
         uint16_t x_filtered = sum / 5;
         
-        adc_data.val = convert_adc_value(x_filtered);
+        int val = convert_adc_value(x_filtered);
         
-        if (adc_data.val != 0) {
-            xQueueSend(xQueueADC, &adc_data, 0);
-            xSemaphoreGive(xSemaphoreEvent); 
+        if (val != 0) {
+            app_signals_publish_axis(AXIS_X, val);
         }
-        
-        vTaskDelay(pdMS_TO_TICKS(10));
+
+        rt_monitor_complete(TASK_ID_X_AXIS);
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(JOYSTICK_PERIOD_MS));
     }
 }
 
-// Task to read Y axis and send to queue
+#if !STRUM_BAR_ENABLED
+// Task to read Y axis and send to queue (o GPIO27 e da palhetada quando ela existe)
 void y_task(void *p) {
     uint16_t y_values[5] = {0};
     int y_index = 0;
     
-    adc_t adc_data;
-    adc_data.axis = 1; // Y axis
-    
+    TickType_t last_wake = xTaskGetTickCount();
     while (1) {
-        adc_select_input(1);
-        y_values[y_index] = adc_read();
+        rt_monitor_release(TASK_ID_Y_AXIS);
+
+        y_values[y_index] = adc_sampler_latest(1);
         y_index = (y_index + 1) % 5;
         
         // Simple moving average filter
@@ -267,33 +272,37 @@ void y_task(void *p) {
         }
         uint16_t y_filtered = sum / 5;
         
-        adc_data.val = convert_adc_value(y_filtered);
+        int val = convert_adc_value(y_filtered);
         
-        if (adc_data.val != 0) {
-            xQueueSend(xQueueADC, &adc_data, 0);
-            xSemaphoreGive(xSemaphoreEvent); 
+        if (val != 0) {
+            app_signals_publish_axis(AXIS_Y, val);
         }
-        
-        vTaskDelay(pdMS_TO_TICKS(10));
+
+        rt_monitor_complete(TASK_ID_Y_AXIS);
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(JOYSTICK_PERIOD_MS));
     }
 }
+#endif
 
 void mpu6050_task(void *p) {
-    // configuracao do I2C
-    i2c_init(i2c_default, 400 * 1000);
-    gpio_set_function(I2C_SDA_GPIO, GPIO_FUNC_I2C);
-    gpio_set_function(I2C_SCL_GPIO, GPIO_FUNC_I2C);
-    gpio_pull_up(I2C_SDA_GPIO);
-    gpio_pull_up(I2C_SCL_GPIO);
+    mpu6050_i2c_init();
 
     FusionAhrs ahrs;
     FusionAhrsInitialise(&ahrs);
 
+    tilt_detector_t tilt;
+    tilt_detector_init(&tilt, NULL);
+
+    sample_clock_init(&imu_clock, MPU6050_PERIOD_MS * 1000);
      
     int16_t acceleration[3], gyro[3], temp;
-  
+
+    TickType_t last_wake = xTaskGetTickCount();
     while (true) { 
-  
+        rt_monitor_release(TASK_ID_MPU6050);
+
+        // dt medido entre leituras: jitter de escalonamento entra na integracao
+        float dt = sample_clock_tick(&imu_clock, time_us_32());
         mpu6050_read_raw(acceleration, gyro, &temp);
         FusionVector gyroscope = {
             .axis.x = gyro[0] / 131.0f, // Conversão para graus/s
@@ -307,19 +316,17 @@ void mpu6050_task(void *p) {
             .axis.z = acceleration[2] / 16384.0f,
         };      
   
-        FusionAhrsUpdateNoMagnetometer(&ahrs, gyroscope, accelerometer, SAMPLE_PERIOD);
+        FusionAhrsUpdateNoMagnetometer(&ahrs, gyroscope, accelerometer, dt);
         // const FusionEuler euler = FusionQuaternionToEuler(FusionAhrsGetQuaternion(&ahrs));
         // printf("Roll %0.1f, Pitch %0.1f, Yaw %0.1f\n", euler.angle.roll, euler.angle.pitch, euler.angle.yaw); 
         
         // criar os structs pra enviar pra fila
   
-        adc_t acel;
-        acel.axis = 2;
-        acel.val = accelerometer.axis.x*100;
+        int acel = accelerometer.axis.x*100;
         static int contador_zeros = 0;
-        //printf("Acel: %d\n", acel.val);
+        //printf("Acel: %d\n", acel);
 
-        if (acel.val == 0) {
+        if (acel == 0) {
             contador_zeros++;
             if (contador_zeros > 50) { 
                 //printf("Sensor travado! Resetando MPU6050...\n");
@@ -331,92 +338,287 @@ void mpu6050_task(void *p) {
         }
 
         
-        if (abs(acel.val) > 150) {
-            printf("SPACE\n");
-            xQueueSend(xQueueADC, &acel, 0);
-            xSemaphoreGive(xSemaphoreEvent); 
+        // Um unico evento por inclinacao, com o angulo em centesimos de grau
+        if (tilt_detector_update(&tilt, FusionAhrsGetGravity(&ahrs), gyroscope,
+                                 dt) == TILT_EVENT_RISE) {
+            app_signals_publish_axis(AXIS_ACCEL, (int)(tilt.angle_deg * 100));
+            star_power_feedback();
         }
-        
-        vTaskDelay(pdMS_TO_TICKS(100));
+        hud_note_tilt(tilt.angle_deg);
+
+        rt_monitor_complete(TASK_ID_MPU6050);
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(MPU6050_PERIOD_MS));
     }
 }
 
+// Whammy no ADC2: so envia quando muda de forma significativa
+void whammy_task(void *p) {
+    whammy_t whammy;
+
+    // Espera o sampler encher e usa a barra solta como repouso
+    vTaskDelay(pdMS_TO_TICKS(WHAMMY_PERIOD_MS));
+    whammy_init(&whammy, adc_sampler_latest(WHAMMY_ADC_CHANNEL));
+
+    TickType_t last_wake = xTaskGetTickCount();
+    while (true) {
+        rt_monitor_release(TASK_ID_WHAMMY);
+
+        int val;
+        if (whammy_update(&whammy, adc_sampler_latest(WHAMMY_ADC_CHANNEL), &val)) {
+            app_signals_publish_axis(AXIS_WHAMMY, val);
+        }
+
+        rt_monitor_complete(TASK_ID_WHAMMY);
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(WHAMMY_PERIOD_MS));
+    }
+}
+
+#if SENSOR_PIPELINE_CORE1
+// Consome as amostras prontas do core 1 (substitui x_task, y_task e mpu6050_task)
+void sensor_consumer_task(void *p) {
+    sensor_core1_start(xTaskGetCurrentTaskHandle());
+
+    tilt_detector_t tilt;
+    tilt_detector_init(&tilt, NULL);
+
+    sensor_sample_t sample;
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        while (sensor_core1_pop(&sample)) {
+            int val;
+
+            val = convert_adc_value(sample.joy_x);
+            if (val != 0) {
+                app_signals_publish_axis(AXIS_X, val);
+            }
+
+#if !STRUM_BAR_ENABLED
+            val = convert_adc_value(sample.joy_y);
+            if (val != 0) {
+                app_signals_publish_axis(AXIS_Y, val);
+            }
+#endif
+
+            if (tilt_detector_update(&tilt, sample.gravity, sample.gyroscope,
+                                     sample.dt_s) == TILT_EVENT_RISE) {
+                app_signals_publish_axis(AXIS_ACCEL, (int)(tilt.angle_deg * 100));
+                star_power_feedback();
+            }
+            hud_note_tilt(tilt.angle_deg);
+
+            rt_monitor_event_complete(TASK_ID_SENSOR_CONSUMER, sample.timestamp_us);
+        }
+    }
+}
+#endif
+
+#define HC06_IRQ_RX_BITS (UART_UARTIMSC_RXIM_BITS | UART_UARTIMSC_RTIM_BITS)
+#define HC06_TX_TIMEOUT_MS 10
+
+static TaskHandle_t hc06_task_handle;
+
+// IRQ do HC-06: desliga a fonte que disparou. RX acorda o radio para
+// esvaziar a FIFO; TX (FIFO abaixo do limiar) libera hc06_write.
+static void hc06_uart_isr(void) {
+    trace_isr_enter(TRACE_ISR_UART_RX);
+    uart_hw_t *hw = uart_get_hw(HC06_UART_ID);
+    uint32_t mis = hw->mis;
+    bool tx = (mis & UART_UARTMIS_TXMIS_BITS) != 0;
+    bool rx = (mis & (UART_UARTMIS_RXMIS_BITS | UART_UARTMIS_RTMIS_BITS)) != 0;
+    hw_clear_bits(&hw->imsc, (tx ? UART_UARTIMSC_TXIM_BITS : 0) | (rx ? HC06_IRQ_RX_BITS : 0));
+    trace_isr_exit(TRACE_ISR_UART_RX);
+
+    BaseType_t woken = pdFALSE;
+    if (tx) {
+        vTaskNotifyGiveFromISR(hc06_task_handle, &woken);
+    }
+    if (rx) {
+        app_signals_notify_from_isr(SIGNAL_UART_RX);
+    }
+    portYIELD_FROM_ISR(woken);
+}
+
+// Unico escritor da UART do HC-06 (so o radio chama): frames de eixo e
+// texto nunca se misturam. Com a FIFO cheia a task bloqueia ate a IRQ de TX.
+static void hc06_write(const void *data, size_t len) {
+    const uint8_t *bytes = data;
+    uart_hw_t *hw = uart_get_hw(HC06_UART_ID);
+
+    for (size_t i = 0; i < len; i++) {
+        while (!uart_is_writable(HC06_UART_ID)) {
+            hw_set_bits(&hw->imsc, UART_UARTIMSC_TXIM_BITS);
+            // Rechecagem: a FIFO pode ter esvaziado antes da IRQ ser ligada
+            if (!uart_is_writable(HC06_UART_ID)) {
+                ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(HC06_TX_TIMEOUT_MS));
+            }
+            hw_clear_bits(&hw->imsc, UART_UARTIMSC_TXIM_BITS);
+        }
+        uart_putc_raw(HC06_UART_ID, bytes[i]);
+    }
+    hud_note_report();
+}
+
 void hc06_task(void *p) {
     uart_init(HC06_UART_ID, HC06_BAUD_RATE);
     gpio_set_function(HC06_TX_PIN, GPIO_FUNC_UART);
     gpio_set_function(HC06_RX_PIN, GPIO_FUNC_UART);
     hc06_init("gabi", "1234");
 
-    // Deixa o LED vermelho aceso inicialmente
-    gpio_put(LED_RED_PIN, 1);
-    gpio_put(LED_GREEN_PIN, 0);
+    hc06_task_handle = xTaskGetCurrentTaskHandle();
+    app_signals_set_radio_task(hc06_task_handle);
+
+    // Respostas AT ja foram lidas por polling; daqui em diante RX e por IRQ
+    irq_set_exclusive_handler(UART1_IRQ, hc06_uart_isr);
+    irq_set_enabled(UART1_IRQ, true);
+    uart_set_irq_enables(HC06_UART_ID, true, false);
 
-    adc_t adc_data;
+    EventGroupHandle_t link = app_signals_link_events();
+    bool rumble_cmd_pending = false;
     while (1) {
-        if (xQueueReceive(xQueueADC, &adc_data, portMAX_DELAY))
-        {
-            uint8_t vec[4];
-            vec[0] = 0xFF; 
-            vec[1] = (uint8_t)adc_data.axis;
-            vec[2] = (uint8_t)(adc_data.val & 0xFF);
-            vec[3] = (uint8_t)((adc_data.val >> 8) & 0xFF);
-            uart_write_blocking(HC06_UART_ID, vec, 4); 
+        uint32_t bits = app_signals_wait(portMAX_DELAY);
+
+        for (int axis = 0; axis < SIGNAL_AXIS_COUNT; axis++) {
+            if (bits & SIGNAL_AXIS(axis)) {
+                int val = app_signals_axis_value(axis);
+                uint8_t vec[4];
+                vec[0] = 0xFF; 
+                vec[1] = (uint8_t)axis;
+                vec[2] = (uint8_t)(val & 0xFF);
+                vec[3] = (uint8_t)((val >> 8) & 0xFF);
+                hc06_write(vec, sizeof(vec));
+                rt_monitor_event_complete(TASK_ID_UART, app_signals_axis_time(axis));
+            }
         }
 
-        if (uart_is_readable(HC06_UART_ID)) {
-            uint8_t lixo;
-            uart_read_blocking(HC06_UART_ID, &lixo, 1);
+        // Texto dos botoes/palhetada; esvazia sempre, inclusive o que chegou
+        // antes do radio registrar o handle
+        app_text_t text;
+        while (app_signals_pop_text(&text)) {
+            hc06_write(text.text, strlen(text.text));
+            rt_monitor_event_complete(TASK_ID_UART, text.event_us);
+        }
+
+        if (bits & SIGNAL_UART_RX) {
+            while (uart_is_readable(HC06_UART_ID)) {
+                char c = uart_getc(HC06_UART_ID);
+
+                // HC06_CMD_RUMBLE + id do efeito; o resto so indica conexao
+                if (rumble_cmd_pending) {
+                    rumble_play((rumble_fx_t)(uint8_t)c);
+                    rumble_cmd_pending = false;
+                } else if (c == HC06_CMD_RUMBLE) {
+                    rumble_cmd_pending = true;
+                }
+            }
 
             // Ao receber qualquer dado, marcamos como conectado
-            if (uxSemaphoreGetCount(conexao_semaphore) == 0) {
-                xSemaphoreGive(conexao_semaphore);
-                gpio_put(LED_RED_PIN, 0);
-                gpio_put(LED_GREEN_PIN, 1);
+            if ((xEventGroupGetBits(link) & LINK_BT_CONNECTED) == 0) {
+                xEventGroupSetBits(link, LINK_BT_CONNECTED);
+                rumble_play(RUMBLE_FX_CONNECTED);
             }
-            
-        }         
+
+            hw_set_bits(&uart_get_hw(HC06_UART_ID)->imsc, HC06_IRQ_RX_BITS);
+            rt_monitor_event_complete(TASK_ID_UART, app_signals_isr_time());
+        }
     }
 }
 
 
-
+RTOS_STATIC_TASK(button, TASK_STACK_BUTTON);
+#if SENSOR_PIPELINE_CORE1
+RTOS_STATIC_TASK(sensor_consumer, TASK_STACK_SENSOR_CONSUMER);
+#else
+RTOS_STATIC_TASK(x_axis, TASK_STACK_JOYSTICK);
+#if !STRUM_BAR_ENABLED
+RTOS_STATIC_TASK(y_axis, TASK_STACK_JOYSTICK);
+#endif
+RTOS_STATIC_TASK(mpu6050, TASK_STACK_MPU6050);
+#endif
+RTOS_STATIC_TASK(uart, TASK_STACK_UART);
+RTOS_STATIC_TASK(usb_link, TASK_STACK_USB_LINK);
+RTOS_STATIC_TASK(whammy, TASK_STACK_WHAMMY);
+RTOS_STATIC_TASK(hud, TASK_STACK_HUD);
+
+
+// Tabela de tasks: prioridade e periodo por classe de latencia
+static const task_config_t task_table[] = {
+    {TASK_ID_BUTTON, task_button_serial, "Button Serial", TASK_STACK_BUTTON, TASK_PRIO_INPUT, 0, 2000,
+     RTOS_TASK_BUFFERS(button)},
+#if SENSOR_PIPELINE_CORE1
+    // ADC, I2C e AHRS rodam bare-metal no core 1
+    {TASK_ID_SENSOR_CONSUMER, sensor_consumer_task, "Sensor Consumer", TASK_STACK_SENSOR_CONSUMER,
+     TASK_PRIO_SAMPLING, 0, 10000, RTOS_TASK_BUFFERS(sensor_consumer)},
+#else
+    {TASK_ID_X_AXIS, x_task, "X Axis Task", TASK_STACK_JOYSTICK, TASK_PRIO_SAMPLING, JOYSTICK_PERIOD_MS, 10000,
+     RTOS_TASK_BUFFERS(x_axis)},
+#if !STRUM_BAR_ENABLED
+    {TASK_ID_Y_AXIS, y_task, "Y Axis Task", TASK_STACK_JOYSTICK, TASK_PRIO_SAMPLING, JOYSTICK_PERIOD_MS, 10000,
+     RTOS_TASK_BUFFERS(y_axis)},
+#endif
+    {TASK_ID_MPU6050, mpu6050_task, "mpu6050_Task", TASK_STACK_MPU6050, TASK_PRIO_FUSION, MPU6050_PERIOD_MS, 100000,
+     RTOS_TASK_BUFFERS(mpu6050)},
+#endif
+    // Deadline contado da publicacao do eixo / IRQ de RX ate o envio
+    {TASK_ID_UART, hc06_task, "UART_Task", TASK_STACK_UART, TASK_PRIO_RADIO, 0, 2000,
+     RTOS_TASK_BUFFERS(uart)},
+    {TASK_ID_WHAMMY, whammy_task, "Whammy", TASK_STACK_WHAMMY, TASK_PRIO_SAMPLING, WHAMMY_PERIOD_MS, 10000,
+     RTOS_TASK_BUFFERS(whammy)},
+    {TASK_ID_USB_LINK, usb_link_task, "USB Link", TASK_STACK_USB_LINK, TASK_PRIO_BACKGROUND, 0, 0,
+     RTOS_TASK_BUFFERS(usb_link)},
+    // Display so desenha quando sobra tempo (ver hud.h)
+    {TASK_ID_HUD, hud_task, "HUD", TASK_STACK_HUD, TASK_PRIO_BACKGROUND, HUD_FRAME_MS, HUD_FRAME_MS * 1000,
+     RTOS_TASK_BUFFERS(hud)},
+};
 
 int main()
 {
     stdio_init_all();
     // printf("Iniciando controle Clone Hero com botoes e joystick...\n");
 
-    // Initialize ADC for joystick
-    adc_init();
-    adc_gpio_init(X_AXIS_PIN);
-    adc_gpio_init(Y_AXIS_PIN);
+    // ADC livre com DMA: joystick e barra de palhetada leem do mesmo ring
+    adc_sampler_init();
     
     // Initialize buttons and their interrupts
+    spsc_ring_init(&button_ring, BUTTON_RING_SIZE);
     init_buttons();
     init_callbacks();
     init_leds();
-
-    //cria semaforo
-    xSemaphoreEvent = xSemaphoreCreateBinary();
-    conexao_semaphore = xSemaphoreCreateBinary();
-
-    // Create queue for ADC values
-    xQueueADC = xQueueCreate(64, sizeof(adc_t));
-    xQueueButtonEvents = xQueueCreate(64, sizeof(button_event_t));
-    
-    if (xQueueADC == NULL) {
-        //printf("Erro ao criar a fila ADC!\n");
-        while(1); 
-    }
+    rumble_init();
+
+    // Sinalizacao por notificacao + event group de conexao
+    app_signals_init();
+
+#if SENSOR_PIPELINE_CORE1
+    rtos_stats_register_clock(sensor_core1_clock());
+    rtos_stats_register_ring("sensor", sensor_core1_ring(), sensor_core1_overflows);
+#else
+    rtos_stats_register_clock(&imu_clock);
+#endif
+    rtos_stats_register_ring("button", &button_ring, button_overflows);
+    rtos_stats_register_ring("text", app_signals_text_ring(), app_signals_text_overflows);
+#if STRUM_BAR_ENABLED
+    rtos_stats_register_ring("strum", strum_ring_state(), strum_overflows);
+#endif
+
+    trace_recorder_register_isr(TRACE_ISR_GPIO, "gpio_irq");
+    trace_recorder_register_isr(TRACE_ISR_SIO_FIFO, "sio_fifo");
+    trace_recorder_register_isr(TRACE_ISR_UART_RX, "uart1");
     // Create tasks
-    //xTaskCreate(monitor_bluetooth_task, "Monitor Bluetooth", 256, NULL, 1, NULL);
-
-    xTaskCreate(task_button_serial, "Button Serial", 512, NULL, 1, NULL);
-    xTaskCreate(x_task, "X Axis Task", 256, NULL, 1, NULL);
-    xTaskCreate(y_task, "Y Axis Task", 256, NULL, 1, NULL);
-    xTaskCreate(mpu6050_task, "mpu6050_Task", 8192, NULL, 1, NULL);
-    // printf("Start bluetooth task\n");
-    xTaskCreate(hc06_task, "UART_Task", 4096, NULL, 1, NULL);
+    for (size_t i = 0; i < count_of(task_table); i++) {
+        const task_config_t *t = &task_table[i];
+        rt_monitor_register(t);
+#if RTOS_STATIC_ALLOCATION
+        bool created = xTaskCreateStatic(t->function, t->name, t->stack_words, NULL, t->priority,
+                                         t->stack, t->tcb) != NULL;
+#else
+        bool created = xTaskCreate(t->function, t->name, t->stack_words, NULL, t->priority, NULL) == pdPASS;
+#endif
+        // Sem bloco livre no heap_pool: melhor parar aqui do que rodar sem a task
+        if (!created) {
+            panic("xTaskCreate: %s", t->name);
+        }
+    }
 
 
     vTaskStartScheduler();
@@ -0,0 +1,55 @@
+#include "mpu6050.h"
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+
+void mpu6050_i2c_init(void) {
+    // configuracao do I2C
+    i2c_init(i2c_default, 400 * 1000);
+    gpio_set_function(MPU6050_SDA_GPIO, GPIO_FUNC_I2C);
+    gpio_set_function(MPU6050_SCL_GPIO, GPIO_FUNC_I2C);
+    gpio_pull_up(MPU6050_SDA_GPIO);
+    gpio_pull_up(MPU6050_SCL_GPIO);
+}
+
+void mpu6050_reset(void) {
+    // Two byte reset. First byte register, second byte data
+    // There are a load more options to set up the device in different ways that could be added here
+    uint8_t buf[] = {MPUREG_PWR_MGMT_1, 0x00};
+    i2c_write_blocking(i2c_default, MPU6050_I2C_DEFAULT, buf, 2, false);
+}
+
+void mpu6050_read_raw(int16_t accel[3], int16_t gyro[3], int16_t *temp) {
+    // For this particular device, we send the device the register we want to read
+    // first, then subsequently read from the device. The register is auto incrementing
+    // so we don't need to keep sending the register we want, just the first.
+
+    uint8_t buffer[6];
+
+    // Start reading acceleration registers from register 0x3B for 6 bytes
+    uint8_t val = MPUREG_ACCEL_XOUT_H;
+    i2c_write_blocking(i2c_default, MPU6050_I2C_DEFAULT, &val, 1, true); // true to keep master control of bus
+    i2c_read_blocking(i2c_default, MPU6050_I2C_DEFAULT, buffer, 6, false);
+
+    for (int i = 0; i < 3; i++) {
+        accel[i] = (buffer[i * 2] << 8 | buffer[(i * 2) + 1]);
+    }
+
+    // Now gyro data from reg 0x43 for 6 bytes
+    // The register is auto incrementing on each read
+    val = MPUREG_GYRO_XOUT_H;
+    i2c_write_blocking(i2c_default, MPU6050_I2C_DEFAULT, &val, 1, true);
+    i2c_read_blocking(i2c_default, MPU6050_I2C_DEFAULT, buffer, 6, false);  // False - finished with bus
+
+    for (int i = 0; i < 3; i++) {
+        gyro[i] = (buffer[i * 2] << 8 | buffer[(i * 2) + 1]);
+    }
+
+    // Now temperature from reg 0x41 for 2 bytes
+    // The register is auto incrementing on each read
+    val = MPUREG_TEMP_OUT_H;
+    i2c_write_blocking(i2c_default, MPU6050_I2C_DEFAULT, &val, 1, true);
+    i2c_read_blocking(i2c_default, MPU6050_I2C_DEFAULT, buffer, 2, false);  // False - finished with bus
+
+    *temp = buffer[0] << 8 | buffer[1];
+}
@@ -1,7 +1,11 @@
 #ifndef __MPU6000_H__
 #define __MPU6000_H__
 
+#include <stdint.h>
+
 #define MPU6050_I2C_DEFAULT 0x68
+#define MPU6050_SDA_GPIO 8
+#define MPU6050_SCL_GPIO 9
 
 // MPU 6000 registers
 #define MPUREG_WHOAMI 0x75     //
@@ -35,4 +39,8 @@
 #define MPUREG_FIFO_R_W 0x74
 #define MPUREG_PRODUCT_ID 0x0C // Product ID Register
 
-#endif // __MPU6000_H__
\ No newline at end of file
+void mpu6050_i2c_init(void);
+void mpu6050_reset(void);
+void mpu6050_read_raw(int16_t accel[3], int16_t gyro[3], int16_t *temp);
+
+#endif // __MPU6000_H__
@@ -0,0 +1,74 @@
+#include "rt_monitor.h"
+
+#include "pico/stdlib.h"
+
+#include <string.h>
+
+static rt_task_stats_t rt_stats[TASK_ID_COUNT];
+
+static void rt_monitor_record(rt_task_stats_t *s, uint32_t response_us) {
+    s->jobs++;
+    s->last_response_us = response_us;
+    if (response_us > s->worst_response_us) {
+        s->worst_response_us = response_us;
+    }
+    if (s->deadline_us && response_us > s->deadline_us) {
+        s->misses++;
+    }
+}
+
+void rt_monitor_register(const task_config_t *cfg) {
+    rt_task_stats_t *s = &rt_stats[cfg->id];
+
+    memset(s, 0, sizeof(*s));
+    s->name = cfg->name;
+    s->period_us = cfg->period_ms * 1000;
+    s->deadline_us = cfg->deadline_us;
+}
+
+void rt_monitor_release(task_id_t id) {
+    rt_task_stats_t *s = &rt_stats[id];
+    uint32_t now = time_us_32();
+
+    if (s->jobs == 0 && s->release_us == 0) {
+        s->release_us = now;
+        return;
+    }
+
+    s->release_us += s->period_us;
+
+    // Acordou um periodo inteiro (ou mais) atrasado: os jobs pulados contam
+    // como deadlines perdidos e a referencia e realinhada.
+    uint32_t late = now - s->release_us;
+    if (s->period_us && (int32_t)late >= (int32_t)s->period_us) {
+        s->misses += late / s->period_us;
+        s->release_us = now;
+    }
+}
+
+void rt_monitor_complete(task_id_t id) {
+    rt_task_stats_t *s = &rt_stats[id];
+    int32_t response = (int32_t)(time_us_32() - s->release_us);
+
+    // O tick e o timer de 1 MHz nao sao alinhados: acordar alguns us antes
+    // da liberacao ideal conta como resposta zero.
+    rt_monitor_record(s, response > 0 ? (uint32_t)response : 0);
+}
+
+void rt_monitor_event_complete(task_id_t id, uint32_t event_us) {
+    rt_monitor_record(&rt_stats[id], time_us_32() - event_us);
+}
+
+const rt_task_stats_t *rt_monitor_get(task_id_t id) {
+    return &rt_stats[id];
+}
+
+void rt_monitor_reset(void) {
+    for (int i = 0; i < TASK_ID_COUNT; i++) {
+        rt_task_stats_t *s = &rt_stats[i];
+        s->jobs = 0;
+        s->misses = 0;
+        s->last_response_us = 0;
+        s->worst_response_us = 0;
+    }
+}
@@ -0,0 +1,35 @@
+#ifndef RT_MONITOR_H_
+#define RT_MONITOR_H_
+
+#include <stdint.h>
+
+#include "task_config.h"
+
+typedef struct {
+    const char *name;
+    uint32_t period_us;   // 0 = disparada por evento
+    uint32_t deadline_us;
+    uint32_t jobs;        // execucoes completas
+    uint32_t misses;      // deadlines perdidos (inclui periodos pulados)
+    uint32_t last_response_us;
+    uint32_t worst_response_us;
+    uint32_t release_us;  // liberacao esperada do job atual
+} rt_task_stats_t;
+
+void rt_monitor_register(const task_config_t *cfg);
+
+/*
+ * Periodic tasks: call rt_monitor_release() right after waking for a new
+ * period and rt_monitor_complete() when the job is done. The response time
+ * is measured from the ideal release instant, so wake-up latency counts.
+ */
+void rt_monitor_release(task_id_t id);
+void rt_monitor_complete(task_id_t id);
+
+// Event-driven tasks: response time measured from the event timestamp.
+void rt_monitor_event_complete(task_id_t id, uint32_t event_us);
+
+const rt_task_stats_t *rt_monitor_get(task_id_t id);
+void rt_monitor_reset(void);
+
+#endif // RT_MONITOR_H_
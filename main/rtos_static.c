@@ -0,0 +1,38 @@
+#include "rtos_static.h"
+
+#include "pico/stdlib.h"
+
+#if RTOS_STATIC_ALLOCATION
+
+// Sem heap, o kernel pede a memoria da idle task e da timer task aqui
+static StackType_t rtos_static_idle_stack[configMINIMAL_STACK_SIZE];
+static StaticTask_t rtos_static_idle_tcb;
+static StackType_t rtos_static_timer_stack[configTIMER_TASK_STACK_DEPTH];
+static StaticTask_t rtos_static_timer_tcb;
+
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer,
+                                   StackType_t **ppxIdleTaskStackBuffer,
+                                   uint32_t *pulIdleTaskStackSize) {
+    *ppxIdleTaskTCBBuffer = &rtos_static_idle_tcb;
+    *ppxIdleTaskStackBuffer = rtos_static_idle_stack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer,
+                                    StackType_t **ppxTimerTaskStackBuffer,
+                                    uint32_t *pulTimerTaskStackSize) {
+    *ppxTimerTaskTCBBuffer = &rtos_static_timer_tcb;
+    *ppxTimerTaskStackBuffer = rtos_static_timer_stack;
+    *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+
+#endif // RTOS_STATIC_ALLOCATION
+
+#if configCHECK_FOR_STACK_OVERFLOW
+// Estouro de pilha detectado na troca de contexto: a memoria vizinha ja
+// pode estar corrompida, entao para aqui com o nome da task
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName) {
+    (void)xTask;
+    panic("stack overflow: %s", pcTaskName);
+}
+#endif
@@ -0,0 +1,45 @@
+#ifndef RTOS_STATIC_H_
+#define RTOS_STATIC_H_
+
+#include <FreeRTOS.h>
+#include <task.h>
+#include <event_groups.h>
+#include <timers.h>
+
+/*
+ * Declaracao/criacao de objetos do RTOS que compila nos dois modos.
+ *
+ * Com RTOS_STATIC_ALLOCATION os buffers viram variaveis globais com o
+ * prefixo `rtos_static_`, que o tools/ram_report.py procura no ELF para
+ * gerar o relatorio de RAM e checar o orcamento (RTOS_RAM_BUDGET).
+ * Sem ele, os mesmos macros caem no xTaskCreate/xEventGroupCreate do heap.
+ */
+#if RTOS_STATIC_ALLOCATION
+
+#define RTOS_STATIC_TASK(name, words)              \
+    static StackType_t rtos_static_##name##_stack[words]; \
+    static StaticTask_t rtos_static_##name##_tcb
+#define RTOS_TASK_BUFFERS(name) rtos_static_##name##_stack, &rtos_static_##name##_tcb
+
+#define RTOS_STATIC_EVENT_GROUP(name) static StaticEventGroup_t rtos_static_##name##_events
+#define RTOS_EVENT_GROUP_CREATE(name) xEventGroupCreateStatic(&rtos_static_##name##_events)
+
+#define RTOS_STATIC_TIMER(name) static StaticTimer_t rtos_static_##name##_timer
+#define RTOS_TIMER_CREATE(name, label, period, reload, id, callback) \
+    xTimerCreateStatic(label, period, reload, id, callback, &rtos_static_##name##_timer)
+
+#else
+
+#define RTOS_STATIC_TASK(name, words) extern int rtos_static_unused_##name
+#define RTOS_TASK_BUFFERS(name) NULL, NULL
+
+#define RTOS_STATIC_EVENT_GROUP(name) extern int rtos_static_unused_##name
+#define RTOS_EVENT_GROUP_CREATE(name) xEventGroupCreate()
+
+#define RTOS_STATIC_TIMER(name) extern int rtos_static_unused_##name
+#define RTOS_TIMER_CREATE(name, label, period, reload, id, callback) \
+    xTimerCreate(label, period, reload, id, callback)
+
+#endif // RTOS_STATIC_ALLOCATION
+
+#endif // RTOS_STATIC_H_
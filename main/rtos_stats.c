@@ -0,0 +1,113 @@
+/*
+ * Per-task CPU usage, stack high-water marks and SPSC ring depths, serialized
+ * into a binary frame on USB CDC.
+ *
+ * CPU usage is the share of run time (1 MHz stats clock) each task got since
+ * the previous frame, so a busy task shows up immediately instead of being
+ * diluted by the total uptime.
+ */
+#include "rtos_stats.h"
+
+#include "pico/stdlib.h"
+
+#include <string.h>
+
+#include "usb_frame.h"
+
+#define RTOS_STATS_TASK_LEN (8 + RTOS_STATS_NAME_LEN)
+#define RTOS_STATS_RING_LEN (12 + RTOS_STATS_RING_NAME_LEN)
+#define RTOS_STATS_CLOCK_LEN 16
+#define RTOS_STATS_PAYLOAD_MAX \
+    (10 + RTOS_STATS_MAX_TASKS * RTOS_STATS_TASK_LEN + RTOS_STATS_MAX_RINGS * RTOS_STATS_RING_LEN + \
+     RTOS_STATS_CLOCK_LEN)
+
+typedef struct {
+    const char *name;
+    const spsc_ring_t *ring;
+    uint32_t (*overflows)(void);
+    uint16_t peak;
+} stats_ring_t;
+
+static stats_ring_t stats_rings[RTOS_STATS_MAX_RINGS];
+static int stats_ring_count;
+static const sample_clock_t *stats_clock;
+
+static TaskStatus_t stats_status[RTOS_STATS_MAX_TASKS];
+static uint32_t stats_prev_runtime[RTOS_STATS_MAX_TASKS];
+static uint8_t stats_payload[RTOS_STATS_PAYLOAD_MAX];
+static uint16_t stats_seq;
+static uint32_t stats_last_us;
+
+void rtos_stats_register_clock(const sample_clock_t *clock) {
+    stats_clock = clock;
+}
+
+void rtos_stats_register_ring(const char *name, const spsc_ring_t *ring, uint32_t (*overflows)(void)) {
+    if (ring == NULL || stats_ring_count >= RTOS_STATS_MAX_RINGS) {
+        return;
+    }
+    stats_rings[stats_ring_count] = (stats_ring_t){name, ring, overflows, 0};
+    stats_ring_count++;
+}
+
+static size_t rtos_stats_build_payload(uint32_t window_us) {
+    UBaseType_t n_tasks = uxTaskGetSystemState(stats_status, RTOS_STATS_MAX_TASKS, NULL);
+    uint8_t *p = stats_payload;
+
+    p = usb_frame_put_u32(p, time_us_32());
+    p = usb_frame_put_u32(p, window_us);
+    *p++ = (uint8_t)n_tasks;
+    *p++ = (uint8_t)stats_ring_count;
+
+    for (UBaseType_t i = 0; i < n_tasks; i++) {
+        const TaskStatus_t *t = &stats_status[i];
+        UBaseType_t slot = t->xTaskNumber % RTOS_STATS_MAX_TASKS;
+        uint32_t ran = t->ulRunTimeCounter - stats_prev_runtime[slot];
+        stats_prev_runtime[slot] = t->ulRunTimeCounter;
+
+        *p++ = (uint8_t)t->xTaskNumber;
+        *p++ = (uint8_t)t->uxCurrentPriority;
+        *p++ = (uint8_t)t->eCurrentState;
+        *p++ = 0;
+        p = usb_frame_put_u16(p, window_us ? (uint16_t)(((uint64_t)ran * 1000) / window_us) : 0);
+        p = usb_frame_put_u16(p, t->usStackHighWaterMark);
+        strncpy((char *)p, t->pcTaskName, RTOS_STATS_NAME_LEN);
+        p += RTOS_STATS_NAME_LEN;
+    }
+
+    // Ocupacao lida sem trava: head e tail sao palavras escritas por um lado so
+    for (int i = 0; i < stats_ring_count; i++) {
+        stats_ring_t *r = &stats_rings[i];
+        uint32_t pending = spsc_ring_count(r->ring);
+        if (pending > r->peak) {
+            r->peak = pending;
+        }
+
+        strncpy((char *)p, r->name, RTOS_STATS_RING_NAME_LEN);
+        p += RTOS_STATS_RING_NAME_LEN;
+        p = usb_frame_put_u16(p, pending);
+        p = usb_frame_put_u16(p, r->ring->mask + 1);
+        p = usb_frame_put_u16(p, r->peak);
+        p = usb_frame_put_u16(p, 0);
+        p = usb_frame_put_u32(p, r->overflows ? r->overflows() : 0);
+    }
+
+    // Campos de 32 bits: leitura atomica mesmo com o core 1 escrevendo
+    const sample_clock_t *c = stats_clock;
+    p = usb_frame_put_u32(p, c ? c->samples : 0);
+    p = usb_frame_put_u32(p, c ? c->clamped : 0);
+    p = usb_frame_put_u32(p, c ? c->jitter_max_us : 0);
+    p = usb_frame_put_u32(p, c ? c->jitter_avg_q4 : 0);
+
+    return p - stats_payload;
+}
+
+void rtos_stats_send(void) {
+    uint32_t now = time_us_32();
+    size_t len = rtos_stats_build_payload(now - stats_last_us);
+    stats_last_us = now;
+
+    usb_frame_begin(USB_FRAME_TYPE_STATS, RTOS_STATS_VERSION, stats_seq++, len);
+    usb_frame_write(stats_payload, len);
+    usb_frame_end();
+}
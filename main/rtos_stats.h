@@ -0,0 +1,47 @@
+#ifndef RTOS_STATS_H_
+#define RTOS_STATS_H_
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <stdint.h>
+
+#include "sample_clock.h"
+#include "spsc_ring.h"
+
+#define RTOS_STATS_PERIOD_MS 1000
+#define RTOS_STATS_MAX_TASKS 16
+#define RTOS_STATS_MAX_RINGS 4
+
+/*
+ * Payload do frame USB_FRAME_TYPE_STATS (ver usb_frame.h):
+ *
+ *   u32 uptime_us
+ *   u32 window_us        duracao da janela medida
+ *   u8  n_tasks
+ *   u8  n_rings
+ *   n_tasks x  { u8 number, u8 priority, u8 state, u8 pad,
+ *                u16 cpu_permille, u16 stack_free_words,
+ *                char name[RTOS_STATS_NAME_LEN] }
+ *   n_rings x  { char name[RTOS_STATS_RING_NAME_LEN], u16 pending, u16 capacity,
+ *                u16 peak_pending, u16 pad, u32 overflows }
+ *                      (peak = maior valor visto nas amostragens;
+ *                       overflows = itens descartados com o ring cheio)
+ *   u32 imu_samples, u32 imu_clamped, u32 imu_jitter_max_us,
+ *   u32 imu_jitter_avg_q4   relogio do IMU registrado (ver sample_clock.h),
+ *                           zeros sem relogio
+ */
+#define RTOS_STATS_VERSION 3
+#define RTOS_STATS_NAME_LEN 12
+#define RTOS_STATS_RING_NAME_LEN 8
+
+// Ring SPSC (botoes, texto do radio, palhetada, core 1) e seu contador de descartes
+void rtos_stats_register_ring(const char *name, const spsc_ring_t *ring, uint32_t (*overflows)(void));
+
+// Relogio de amostragem do IMU do pipeline ativo (task ou core 1)
+void rtos_stats_register_clock(const sample_clock_t *clock);
+
+// Mede a janela desde o ultimo envio e manda um frame pela USB.
+void rtos_stats_send(void);
+
+#endif // RTOS_STATS_H_
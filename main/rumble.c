@@ -0,0 +1,156 @@
+#include "rumble.h"
+
+#include "pico/stdlib.h"
+#include "hardware/pwm.h"
+#include "hardware/timer.h"
+#include "hardware/clocks.h"
+#include "hardware/sync.h"
+
+#define RUMBLE_PWM_WRAP 255
+
+static const rumble_step_t fx_click[] = {
+    {200, 200, 20},
+};
+
+static const rumble_step_t fx_note_miss[] = {
+    {255, 255, 60},
+    {0, 0, 40},
+    {255, 120, 80},
+};
+
+static const rumble_step_t fx_connected[] = {
+    {160, 160, 50},
+    {0, 0, 50},
+};
+
+// Ataque rapido, sustenta e decai devagar
+static const rumble_step_t fx_star_power[] = {
+    {0, 255, 50},
+    {255, 255, 300},
+    {255, 0, 400},
+};
+
+static const rumble_effect_t effects[RUMBLE_FX_COUNT] = {
+    [RUMBLE_FX_CLICK] = {fx_click, count_of(fx_click), 0, 0},
+    [RUMBLE_FX_NOTE_MISS] = {fx_note_miss, count_of(fx_note_miss), 0, 1},
+    [RUMBLE_FX_CONNECTED] = {fx_connected, count_of(fx_connected), 1, 1},
+    [RUMBLE_FX_STAR_POWER] = {fx_star_power, count_of(fx_star_power), 0, 2},
+};
+
+static uint rumble_slice;
+static uint rumble_channel;
+static int rumble_alarm = -1;
+
+// Estado do sequenciador; alterado no alarme e em rumble_play com IRQs desligadas
+static const rumble_effect_t *current;
+static uint8_t step;
+static uint8_t repeats_left;
+static uint16_t elapsed_ms;
+static absolute_time_t next_tick;
+
+static void rumble_set_level(uint8_t level) {
+    pwm_set_chan_level(rumble_slice, rumble_channel, level);
+}
+
+static uint8_t rumble_step_level(const rumble_step_t *s, uint16_t t_ms) {
+    if (s->ms == 0) {
+        return s->to;
+    }
+    return s->from + ((int)s->to - s->from) * t_ms / s->ms;
+}
+
+static void rumble_arm(void) {
+    next_tick = delayed_by_us(next_tick, RUMBLE_TICK_US);
+    // Alvo ja passou (IRQs bloqueadas por muito tempo): recomeca de agora
+    if (hardware_alarm_set_target(rumble_alarm, next_tick)) {
+        next_tick = make_timeout_time_us(RUMBLE_TICK_US);
+        hardware_alarm_set_target(rumble_alarm, next_tick);
+    }
+}
+
+static void rumble_alarm_callback(uint alarm_num) {
+    (void)alarm_num;
+    if (current == NULL) {
+        return;
+    }
+
+    elapsed_ms += RUMBLE_TICK_US / 1000;
+    if (elapsed_ms >= current->steps[step].ms) {
+        elapsed_ms = 0;
+        if (++step >= current->count) {
+            step = 0;
+            if (repeats_left == 0) {
+                current = NULL;
+                rumble_set_level(0);
+                return;
+            }
+            repeats_left--;
+        }
+    }
+
+    rumble_set_level(rumble_step_level(&current->steps[step], elapsed_ms));
+    rumble_arm();
+}
+
+void rumble_init(void) {
+    gpio_set_function(RUMBLE_GPIO, GPIO_FUNC_PWM);
+    rumble_slice = pwm_gpio_to_slice_num(RUMBLE_GPIO);
+    rumble_channel = pwm_gpio_to_channel(RUMBLE_GPIO);
+
+    pwm_config config = pwm_get_default_config();
+    pwm_config_set_wrap(&config, RUMBLE_PWM_WRAP);
+    pwm_config_set_clkdiv(&config, (float)clock_get_hz(clk_sys) / (RUMBLE_PWM_HZ * (RUMBLE_PWM_WRAP + 1)));
+    pwm_init(rumble_slice, &config, true);
+    rumble_set_level(0);
+
+    rumble_alarm = hardware_alarm_claim_unused(true);
+    hardware_alarm_set_callback(rumble_alarm, rumble_alarm_callback);
+}
+
+bool rumble_play_effect(const rumble_effect_t *effect) {
+    if (rumble_alarm < 0 || effect == NULL || effect->count == 0) {
+        return false;
+    }
+
+    uint32_t irq = save_and_disable_interrupts();
+    if (current != NULL && current->priority > effect->priority) {
+        restore_interrupts(irq);
+        return false;
+    }
+
+    bool idle = current == NULL;
+    current = effect;
+    step = 0;
+    repeats_left = effect->repeat;
+    elapsed_ms = 0;
+    rumble_set_level(effect->steps[0].from);
+
+    // Com efeito em andamento o alarme ja esta armado e so troca o estado
+    if (idle) {
+        next_tick = get_absolute_time();
+        rumble_arm();
+    }
+    restore_interrupts(irq);
+    return true;
+}
+
+bool rumble_play(rumble_fx_t fx) {
+    if ((unsigned)fx >= RUMBLE_FX_COUNT) {
+        return false;
+    }
+    return rumble_play_effect(&effects[fx]);
+}
+
+void rumble_stop(void) {
+    uint32_t irq = save_and_disable_interrupts();
+    current = NULL;
+    rumble_set_level(0);
+    if (rumble_alarm >= 0) {
+        hardware_alarm_cancel(rumble_alarm);
+    }
+    restore_interrupts(irq);
+}
+
+bool rumble_is_playing(void) {
+    return current != NULL;
+}
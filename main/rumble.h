@@ -0,0 +1,51 @@
+#ifndef RUMBLE_H_
+#define RUMBLE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Motor de vibracao no PWM de hardware.
+ *
+ * Cada efeito e uma sequencia de passos (rampa linear de intensidade por
+ * uma duracao), com repeticoes e prioridade. O sequenciador roda num
+ * alarme de hardware dedicado e so fica armado enquanto ha efeito tocando,
+ * entao nao existe task de polling e o custo parado e zero.
+ */
+
+#define RUMBLE_GPIO 7
+#define RUMBLE_PWM_HZ 20000 // acima do audivel, sem chiado do motor
+#define RUMBLE_TICK_US 5000 // resolucao das rampas
+
+typedef struct {
+    uint8_t from; // intensidade no inicio do passo (0..255)
+    uint8_t to;   // intensidade no fim do passo
+    uint16_t ms;  // duracao do passo
+} rumble_step_t;
+
+typedef struct {
+    const rumble_step_t *steps;
+    uint8_t count;
+    uint8_t repeat;   // repeticoes alem da primeira
+    uint8_t priority; // efeito de prioridade menor nao interrompe um maior
+} rumble_effect_t;
+
+// Efeitos pre-definidos; o numero e o mesmo usado nos comandos do host
+typedef enum {
+    RUMBLE_FX_CLICK = 0,
+    RUMBLE_FX_NOTE_MISS,
+    RUMBLE_FX_CONNECTED,
+    RUMBLE_FX_STAR_POWER,
+    RUMBLE_FX_COUNT
+} rumble_fx_t;
+
+void rumble_init(void);
+
+// Pode ser chamado de task ou ISR. Retorna false se um efeito de prioridade
+// maior estiver tocando (ou o id for invalido).
+bool rumble_play(rumble_fx_t fx);
+bool rumble_play_effect(const rumble_effect_t *effect);
+void rumble_stop(void);
+bool rumble_is_playing(void);
+
+#endif // RUMBLE_H_
@@ -0,0 +1,40 @@
+#include "sample_clock.h"
+
+void sample_clock_init(sample_clock_t *clk, uint32_t nominal_us) {
+    clk->nominal_us = nominal_us;
+    clk->last_us = 0;
+    clk->started = false;
+    clk->samples = 0;
+    clk->clamped = 0;
+    clk->jitter_max_us = 0;
+    clk->jitter_avg_q4 = 0;
+}
+
+float sample_clock_tick(sample_clock_t *clk, uint32_t timestamp_us) {
+    uint32_t dt_us = timestamp_us - clk->last_us; // wrap do contador e ok
+    clk->last_us = timestamp_us;
+    clk->samples++;
+
+    if (!clk->started) {
+        clk->started = true;
+        return clk->nominal_us / 1e6f;
+    }
+
+    uint32_t jitter = dt_us > clk->nominal_us ? dt_us - clk->nominal_us : clk->nominal_us - dt_us;
+    if (jitter > clk->jitter_max_us) {
+        clk->jitter_max_us = jitter;
+    }
+    clk->jitter_avg_q4 += (int32_t)((jitter << 4) - clk->jitter_avg_q4) >> 4;
+
+    uint32_t min_us = clk->nominal_us / SAMPLE_CLOCK_CLAMP_DIV;
+    uint32_t max_us = clk->nominal_us * SAMPLE_CLOCK_CLAMP_MUL;
+    if (dt_us < min_us) {
+        dt_us = min_us;
+        clk->clamped++;
+    } else if (dt_us > max_us) {
+        dt_us = max_us;
+        clk->clamped++;
+    }
+
+    return dt_us / 1e6f;
+}
@@ -0,0 +1,34 @@
+#ifndef SAMPLE_CLOCK_H_
+#define SAMPLE_CLOCK_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Delta time real entre amostras do IMU, a partir do timestamp de cada
+ * leitura (time_us_32 no instante do read).
+ *
+ * O dt fica recortado em [nominal / SAMPLE_CLOCK_CLAMP_DIV,
+ * nominal * SAMPLE_CLOCK_CLAMP_MUL]: um travamento longo (reset do sensor,
+ * breakpoint) nao vira um salto de integracao, e duas leituras coladas nao
+ * zeram o passo. O jitter e o desvio |dt - nominal| antes do recorte.
+ */
+#define SAMPLE_CLOCK_CLAMP_DIV 2
+#define SAMPLE_CLOCK_CLAMP_MUL 4
+
+typedef struct {
+    uint32_t nominal_us;
+    uint32_t last_us;
+    bool started;
+    uint32_t samples;
+    uint32_t clamped;       // dt fora da faixa (recortados)
+    uint32_t jitter_max_us; // maior |dt - nominal|
+    uint32_t jitter_avg_q4; // media movel (1/16) de |dt - nominal|, em us x16
+} sample_clock_t;
+
+void sample_clock_init(sample_clock_t *clk, uint32_t nominal_us);
+
+// Registra uma amostra; retorna o dt em segundos (nominal na primeira)
+float sample_clock_tick(sample_clock_t *clk, uint32_t timestamp_us);
+
+#endif // SAMPLE_CLOCK_H_
@@ -0,0 +1,158 @@
+/*
+ * Sensor pipeline running bare-metal on core 1.
+ *
+ * Core 1 owns the I2C bus: it takes the joystick from the free-running ADC
+ * ring, reads the MPU6050, runs the AHRS and publishes finished samples into
+ * a lock-free SPSC ring in shared SRAM. Each publish rings a doorbell through the SIO FIFO so
+ * the consumer task on core 0 wakes up without polling.
+ */
+#include "sensor_core1.h"
+
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+#include "hardware/irq.h"
+
+#include "mpu6050.h"
+#include "adc_sampler.h"
+#include "sample_clock.h"
+#include "spsc_ring.h"
+#include "trace_recorder.h"
+
+#define SENSOR_AVG_LEN 5
+
+static sensor_sample_t sensor_ring_buf[SENSOR_CORE1_RING_SIZE];
+static spsc_ring_t sensor_ring;
+static volatile uint32_t sensor_overflow_count;
+static TaskHandle_t sensor_consumer;
+static sample_clock_t sensor_clock; // so o core 1 escreve; o core 0 le para as estatisticas
+
+static uint16_t moving_average(uint16_t values[SENSOR_AVG_LEN]) {
+    uint32_t sum = 0;
+    for (int i = 0; i < SENSOR_AVG_LEN; i++) {
+        sum += values[i];
+    }
+    return sum / SENSOR_AVG_LEN;
+}
+
+static void sensor_publish(const sensor_sample_t *sample) {
+    if (spsc_ring_full(&sensor_ring)) {
+        sensor_overflow_count++;
+        return;
+    }
+    sensor_ring_buf[spsc_ring_head_slot(&sensor_ring)] = *sample;
+    spsc_ring_publish(&sensor_ring);
+
+    // Doorbell: o valor nao importa, a fila de amostras esta no ring.
+    // Se a FIFO estiver cheia o core 0 ja tem uma notificacao pendente.
+    if (multicore_fifo_wready()) {
+        multicore_fifo_push_blocking(sample->seq);
+    }
+}
+
+static void sensor_core1_entry(void) {
+    mpu6050_i2c_init();
+    mpu6050_reset();
+
+    FusionAhrs ahrs;
+    FusionAhrsInitialise(&ahrs);
+
+    uint16_t x_values[SENSOR_AVG_LEN] = {0};
+    uint16_t y_values[SENSOR_AVG_LEN] = {0};
+    int avg_index = 0;
+    int contador_zeros = 0;
+    int16_t acceleration[3], gyro[3], temp;
+
+    sensor_sample_t sample = {0};
+    sample_clock_init(&sensor_clock, SENSOR_CORE1_PERIOD_US);
+    uint64_t deadline = time_us_64();
+
+    while (true) {
+        sample.timestamp_us = time_us_32();
+
+        x_values[avg_index] = adc_sampler_latest(0);
+        y_values[avg_index] = adc_sampler_latest(1);
+        avg_index = (avg_index + 1) % SENSOR_AVG_LEN;
+        sample.joy_x = moving_average(x_values);
+        sample.joy_y = moving_average(y_values);
+
+        sample.dt_s = sample_clock_tick(&sensor_clock, time_us_32());
+        mpu6050_read_raw(acceleration, gyro, &temp);
+        sample.gyroscope = (FusionVector){
+            .axis.x = gyro[0] / 131.0f, // Conversão para graus/s
+            .axis.y = gyro[1] / 131.0f,
+            .axis.z = gyro[2] / 131.0f,
+        };
+        sample.accelerometer = (FusionVector){
+            .axis.x = acceleration[0] / 16384.0f, // Conversão para g
+            .axis.y = acceleration[1] / 16384.0f,
+            .axis.z = acceleration[2] / 16384.0f,
+        };
+        FusionAhrsUpdateNoMagnetometer(&ahrs, sample.gyroscope, sample.accelerometer,
+                                       sample.dt_s);
+        sample.quaternion = FusionAhrsGetQuaternion(&ahrs);
+        sample.gravity = FusionAhrsGetGravity(&ahrs);
+
+        if ((int)(sample.accelerometer.axis.x * 100) == 0) {
+            if (++contador_zeros > 50) {
+                mpu6050_reset(); // sensor travado
+                contador_zeros = 0;
+            }
+        } else {
+            contador_zeros = 0;
+        }
+
+        sensor_publish(&sample);
+        sample.seq++;
+
+        // Periodo absoluto: atrasos de uma iteracao nao acumulam
+        deadline += SENSOR_CORE1_PERIOD_US;
+        busy_wait_until(from_us_since_boot(deadline));
+    }
+}
+
+static void sensor_doorbell_isr(void) {
+    trace_isr_enter(TRACE_ISR_SIO_FIFO);
+    while (multicore_fifo_rvalid()) {
+        (void)sio_hw->fifo_rd;
+    }
+    multicore_fifo_clear_irq();
+
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(sensor_consumer, &woken);
+    trace_isr_exit(TRACE_ISR_SIO_FIFO);
+    portYIELD_FROM_ISR(woken);
+}
+
+void sensor_core1_start(TaskHandle_t consumer) {
+    sensor_consumer = consumer;
+    spsc_ring_init(&sensor_ring, SENSOR_CORE1_RING_SIZE);
+
+    // O launch usa a FIFO para o handshake, entao a IRQ so e ligada depois
+    multicore_launch_core1(sensor_core1_entry);
+
+    multicore_fifo_drain();
+    multicore_fifo_clear_irq();
+    irq_set_exclusive_handler(SIO_IRQ_PROC0, sensor_doorbell_isr);
+    irq_set_enabled(SIO_IRQ_PROC0, true);
+}
+
+bool sensor_core1_pop(sensor_sample_t *sample) {
+    if (spsc_ring_empty(&sensor_ring)) {
+        return false;
+    }
+    *sample = sensor_ring_buf[spsc_ring_tail_slot(&sensor_ring)];
+    spsc_ring_release(&sensor_ring);
+    return true;
+}
+
+uint32_t sensor_core1_overflows(void) {
+    return sensor_overflow_count;
+}
+
+const spsc_ring_t *sensor_core1_ring(void) {
+    return &sensor_ring;
+}
+
+const sample_clock_t *sensor_core1_clock(void) {
+    return &sensor_clock;
+}
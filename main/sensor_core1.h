@@ -0,0 +1,50 @@
+#ifndef SENSOR_CORE1_H_
+#define SENSOR_CORE1_H_
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "Fusion.h"
+#include "sample_clock.h"
+#include "spsc_ring.h"
+
+// Periodo fixo do laco do core 1 (sem RTOS, sem time slicing)
+#define SENSOR_CORE1_PERIOD_US 10000
+#define SENSOR_CORE1_RING_SIZE 32 // potencia de 2
+
+// Amostra pronta publicada pelo core 1
+typedef struct {
+    uint32_t timestamp_us;
+    uint32_t seq;
+    uint16_t joy_x;            // ADC0 filtrado (media movel)
+    uint16_t joy_y;            // ADC1 filtrado (media movel); e a palhetada com STRUM_BAR_ENABLED
+    FusionVector accelerometer; // em g
+    FusionVector gyroscope;     // em graus/s
+    FusionQuaternion quaternion;
+    FusionVector gravity;       // FusionAhrsGetGravity, para o detector de inclinacao
+    float dt_s;                 // dt medido desde a leitura anterior do IMU
+} sensor_sample_t;
+
+/*
+ * Launches the bare-metal pipeline on core 1 and routes its doorbell to
+ * `consumer`. Must be called from a running task on core 0: the doorbell
+ * ISR notifies `consumer` and may request a context switch.
+ */
+void sensor_core1_start(TaskHandle_t consumer);
+
+// Consumer side (core 0). Returns false when the ring is empty.
+bool sensor_core1_pop(sensor_sample_t *sample);
+
+// Samples dropped by core 1 because core 0 did not drain the ring in time.
+uint32_t sensor_core1_overflows(void);
+
+// Sample ring indices, for the stats frame (read only).
+const spsc_ring_t *sensor_core1_ring(void);
+
+// dt and jitter of the core-1 IMU reads; written by core 1 only.
+const sample_clock_t *sensor_core1_clock(void);
+
+#endif // SENSOR_CORE1_H_
@@ -0,0 +1,63 @@
+#ifndef SPSC_RING_H_
+#define SPSC_RING_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hardware/sync.h"
+
+/*
+ * Lock-free single-producer / single-consumer ring index.
+ *
+ * The ring only tracks indices; the caller owns the slot array (size must be
+ * a power of two). The producer only writes `head`, the consumer only writes
+ * `tail`, so the same ring works between an ISR and a task or between the two
+ * RP2040 cores without critical sections. The memory barrier before each index
+ * update makes the slot contents visible before the index that publishes them.
+ */
+typedef struct {
+    volatile uint32_t head; // escrito somente pelo produtor
+    volatile uint32_t tail; // escrito somente pelo consumidor
+    uint32_t mask;
+} spsc_ring_t;
+
+static inline void spsc_ring_init(spsc_ring_t *r, uint32_t size) {
+    r->head = 0;
+    r->tail = 0;
+    r->mask = size - 1;
+}
+
+static inline uint32_t spsc_ring_count(const spsc_ring_t *r) {
+    return r->head - r->tail;
+}
+
+static inline bool spsc_ring_empty(const spsc_ring_t *r) {
+    return r->head == r->tail;
+}
+
+static inline bool spsc_ring_full(const spsc_ring_t *r) {
+    return (r->head - r->tail) > r->mask;
+}
+
+// Producer side: slot to fill, then publish it.
+static inline uint32_t spsc_ring_head_slot(const spsc_ring_t *r) {
+    return r->head & r->mask;
+}
+
+static inline void spsc_ring_publish(spsc_ring_t *r) {
+    __dmb();
+    r->head = r->head + 1;
+}
+
+// Consumer side: slot to read, then release it back to the producer.
+static inline uint32_t spsc_ring_tail_slot(const spsc_ring_t *r) {
+    __dmb();
+    return r->tail & r->mask;
+}
+
+static inline void spsc_ring_release(spsc_ring_t *r) {
+    __dmb();
+    r->tail = r->tail + 1;
+}
+
+#endif // SPSC_RING_H_
@@ -0,0 +1,138 @@
+#include "strum.h"
+
+#include <stdlib.h>
+
+#include "pico/stdlib.h"
+
+#include "adc_sampler.h"
+#include "spsc_ring.h"
+
+typedef enum {
+    STRUM_STATE_IDLE = 0, // barra no centro, atualizando centro e ruido
+    STRUM_STATE_STROKE,   // fora do limiar, esperando voltar
+} strum_state_t;
+
+static struct {
+    strum_state_t state;
+    int32_t center_q4;    // centro em ponto fixo (x16)
+    int32_t noise_q4;     // desvio medio em repouso (x16)
+    uint32_t last_event_us;
+    strum_event_t pending;
+    uint32_t next_pos;    // proxima posicao do adc_sampler a processar
+    bool primed;
+} strum;
+
+static strum_event_t strum_ring_buf[STRUM_RING_SIZE];
+static spsc_ring_t strum_ring;
+static volatile uint32_t strum_overflow_count;
+static TaskHandle_t strum_consumer;
+static repeating_timer_t strum_timer;
+
+static int32_t strum_threshold(void) {
+    int32_t thr = (strum.noise_q4 * STRUM_NOISE_GAIN) >> 4;
+    return thr > STRUM_MIN_THRESHOLD ? thr : STRUM_MIN_THRESHOLD;
+}
+
+static void strum_emit(BaseType_t *woken) {
+    if (spsc_ring_full(&strum_ring)) {
+        strum_overflow_count++;
+        return;
+    }
+    strum_ring_buf[spsc_ring_head_slot(&strum_ring)] = strum.pending;
+    spsc_ring_publish(&strum_ring);
+    vTaskNotifyGiveFromISR(strum_consumer, woken);
+}
+
+// Retorna true se a amostra iniciou uma palhetada
+static bool strum_feed(uint16_t sample, uint32_t pos) {
+    int32_t dev = (int32_t)sample - (strum.center_q4 >> 4);
+    int32_t thr = strum_threshold();
+
+    if (strum.state == STRUM_STATE_IDLE) {
+        if (abs(dev) < thr) {
+            // Repouso: EMA lenta do centro (1/64) e do ruido (1/32)
+            strum.center_q4 += (((int32_t)sample << 4) - strum.center_q4) >> 6;
+            strum.noise_q4 += ((abs(dev) << 4) - strum.noise_q4) >> 5;
+            return false;
+        }
+
+        uint32_t t = adc_sampler_time_us(pos);
+        if (t - strum.last_event_us < STRUM_REFRACTORY_US) {
+            return false; // repique mecanico da barra
+        }
+
+        strum.state = STRUM_STATE_STROKE;
+        strum.last_event_us = t;
+        strum.pending.timestamp_us = t;
+        strum.pending.direction = dev > 0 ? STRUM_DOWN : STRUM_UP;
+        strum.pending.peak = abs(dev);
+        return true;
+    }
+
+    if (abs(dev) > strum.pending.peak) {
+        strum.pending.peak = abs(dev);
+    }
+    // Histerese: so rearma abaixo de metade do limiar
+    if (abs(dev) < thr / 2) {
+        strum.state = STRUM_STATE_IDLE;
+    }
+    return false;
+}
+
+static bool strum_timer_callback(repeating_timer_t *rt) {
+    (void)rt;
+    uint32_t pos = adc_sampler_position();
+    BaseType_t woken = pdFALSE;
+
+    // Sampler reiniciado ou muito atrasado: recomeca do presente
+    if (pos < strum.next_pos || pos - strum.next_pos > ADC_SAMPLER_RING_LEN / 2) {
+        strum.next_pos = pos;
+    }
+
+    for (uint32_t p = strum.next_pos; p != pos; p++) {
+        if (adc_sampler_channel_of(p) != STRUM_ADC_CHANNEL) {
+            continue;
+        }
+        uint16_t sample = adc_sampler_at(p);
+
+        if (!strum.primed) {
+            strum.center_q4 = (int32_t)sample << 4;
+            strum.primed = true;
+        }
+        if (strum_feed(sample, p)) {
+            strum_emit(&woken);
+        }
+    }
+    strum.next_pos = pos;
+
+    // Roda no IRQ do alarm pool: troca de contexto no fim do IRQ, se preciso
+    portYIELD_FROM_ISR(woken);
+    return true;
+}
+
+void strum_start(TaskHandle_t consumer) {
+    strum_consumer = consumer;
+    spsc_ring_init(&strum_ring, STRUM_RING_SIZE);
+    strum.next_pos = adc_sampler_position();
+    strum.last_event_us = time_us_32() - STRUM_REFRACTORY_US;
+
+    // Periodo negativo: intervalo entre inicios, sem deriva
+    add_repeating_timer_us(-STRUM_POLL_US, strum_timer_callback, NULL, &strum_timer);
+}
+
+bool strum_pop(strum_event_t *event) {
+    if (spsc_ring_empty(&strum_ring)) {
+        return false;
+    }
+    *event = strum_ring_buf[spsc_ring_tail_slot(&strum_ring)];
+    spsc_ring_release(&strum_ring);
+    return true;
+}
+
+uint32_t strum_overflows(void) {
+    return strum_overflow_count;
+}
+
+const spsc_ring_t *strum_ring_state(void) {
+    return &strum_ring;
+}
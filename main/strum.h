@@ -0,0 +1,67 @@
+#ifndef STRUM_H_
+#define STRUM_H_
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "spsc_ring.h"
+
+/*
+ * Detector da barra de palhetada analogica.
+ *
+ * Roda num timer repetitivo de 1 ms (alarm pool do SDK) sobre todas as
+ * amostras novas do canal da palhetada no adc_sampler (2 kHz). O centro e
+ * o ruido sao estimados continuamente com a barra em repouso; a palhetada
+ * e detectada quando o sinal sai de centro +- limiar adaptativo e so
+ * rearma depois de voltar perto do centro e de passar a janela refrataria.
+ * Cada evento leva o instante da amostra que cruzou o limiar.
+ */
+
+/*
+ * Pinos: a barra ocupa o ADC1 / GPIO27, que era o eixo Y do joystick (o
+ * Pico so expoe ADC0-2 nos GPIO26-28; o ADC3 le VSYS/3). Com a barra
+ * ligada o eixo Y sai do relatorio de mouse e fica so o X (ADC0 / GPIO26);
+ * o whammy segue no ADC2 / GPIO28. Compilar com STRUM_BAR_ENABLED=0
+ * devolve o GPIO27 ao eixo Y, sem palhetada analogica.
+ */
+#ifndef STRUM_BAR_ENABLED
+#define STRUM_BAR_ENABLED 1
+#endif
+
+#define STRUM_ADC_CHANNEL 1     // ADC1 / GPIO27
+#define STRUM_POLL_US 1000
+#define STRUM_REFRACTORY_US 30000
+#define STRUM_MIN_THRESHOLD 300 // contagens do ADC de 12 bits
+#define STRUM_NOISE_GAIN 6      // limiar = max(minimo, ganho * ruido medio)
+#define STRUM_RING_SIZE 16      // potencia de 2
+
+typedef enum {
+    STRUM_UP = 0,
+    STRUM_DOWN,
+} strum_direction_t;
+
+typedef struct {
+    uint32_t timestamp_us; // amostra que cruzou o limiar
+    uint8_t direction;     // strum_direction_t
+    uint16_t peak;         // desvio maximo do centro no movimento
+} strum_event_t;
+
+/*
+ * Comeca a detectar; cada evento notifica `consumer` (ulTaskNotifyTake).
+ * Depende do adc_sampler ja iniciado.
+ */
+void strum_start(TaskHandle_t consumer);
+
+// Retorna false quando nao ha eventos pendentes
+bool strum_pop(strum_event_t *event);
+
+// Eventos descartados com o ring cheio
+uint32_t strum_overflows(void);
+
+// Indices do ring de eventos, para as estatisticas (somente leitura)
+const spsc_ring_t *strum_ring_state(void);
+
+#endif // STRUM_H_
@@ -0,0 +1,61 @@
+#ifndef TASK_CONFIG_H_
+#define TASK_CONFIG_H_
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <stdint.h>
+
+/*
+ * Prioridades por classe de latencia (maior = mais urgente).
+ * Tarefas periodicas seguem rate-monotonic: periodo menor, prioridade maior.
+ */
+#define TASK_PRIO_INPUT      (tskIDLE_PRIORITY + 5) // botoes -> radio
+#define TASK_PRIO_RADIO      (tskIDLE_PRIORITY + 4) // envio/recepcao HC-06
+#define TASK_PRIO_SAMPLING   (tskIDLE_PRIORITY + 3) // joystick, 10 ms
+#define TASK_PRIO_FUSION     (tskIDLE_PRIORITY + 2) // IMU + AHRS, 100 ms
+#define TASK_PRIO_BACKGROUND (tskIDLE_PRIORITY + 1) // HUD, estatisticas
+
+// Tamanho das pilhas, em palavras de 32 bits. Com STACK_USAGE_ANALYSIS os
+// valores vem do grafo de chamadas (tools/stack_usage.py); os abaixo so
+// valem para o stack_probe e para builds sem a analise.
+#ifdef HAVE_STACK_SIZES_H
+#include "stack_sizes.h"
+#else
+#define TASK_STACK_BUTTON          512
+#define TASK_STACK_JOYSTICK        256
+#define TASK_STACK_MPU6050         8192
+#define TASK_STACK_SENSOR_CONSUMER 512
+#define TASK_STACK_UART            4096
+#define TASK_STACK_USB_LINK        256
+#define TASK_STACK_WHAMMY          256
+#define TASK_STACK_HUD             512
+#endif
+
+// Identificador de cada task da aplicacao (indice no monitor de deadlines)
+typedef enum {
+    TASK_ID_BUTTON = 0,
+    TASK_ID_X_AXIS,
+    TASK_ID_Y_AXIS,
+    TASK_ID_MPU6050,
+    TASK_ID_SENSOR_CONSUMER,
+    TASK_ID_UART,
+    TASK_ID_USB_LINK,
+    TASK_ID_WHAMMY,
+    TASK_ID_HUD,
+    TASK_ID_COUNT
+} task_id_t;
+
+typedef struct {
+    task_id_t id;
+    TaskFunction_t function;
+    const char *name;
+    configSTACK_DEPTH_TYPE stack_words;
+    UBaseType_t priority;
+    uint32_t period_ms;   // 0 = tarefa disparada por evento
+    uint32_t deadline_us; // tempo de resposta maximo aceitavel
+    StackType_t *stack;   // buffers estaticos (NULL com alocacao dinamica)
+    StaticTask_t *tcb;
+} task_config_t;
+
+#endif // TASK_CONFIG_H_
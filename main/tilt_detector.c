@@ -0,0 +1,46 @@
+#include "tilt_detector.h"
+
+#include <math.h>
+
+void tilt_detector_init(tilt_detector_t *tilt, const tilt_config_t *config) {
+    const tilt_config_t defaults = TILT_CONFIG_DEFAULT;
+
+    tilt->config = config ? *config : defaults;
+    tilt->active = false;
+    tilt->held_ms = 0.0f;
+    tilt->angle_deg = 0.0f;
+}
+
+tilt_event_t tilt_detector_update(tilt_detector_t *tilt, FusionVector gravity, FusionVector gyroscope, float dt_s) {
+    const tilt_config_t *c = &tilt->config;
+
+    // Angulo do braco da guitarra (eixo X) com a horizontal, qualquer sentido
+    tilt->angle_deg = FusionRadiansToDegrees(FusionAsin(fabsf(gravity.axis.x)));
+
+    if (tilt->active) {
+        if (tilt->angle_deg < c->exit_deg) {
+            tilt->active = false;
+            tilt->held_ms = 0.0f;
+            return TILT_EVENT_FALL;
+        }
+        return TILT_EVENT_NONE;
+    }
+
+    if (tilt->angle_deg < c->enter_deg) {
+        tilt->held_ms = 0.0f;
+        return TILT_EVENT_NONE;
+    }
+
+    // Sacudida: segura a contagem ate o movimento acalmar
+    float rate_sq = FusionVectorMagnitudeSquared(gyroscope);
+    if (rate_sq > c->max_rate_dps * c->max_rate_dps) {
+        return TILT_EVENT_NONE;
+    }
+
+    tilt->held_ms += dt_s * 1000.0f;
+    if (tilt->held_ms >= c->hold_ms) {
+        tilt->active = true;
+        return TILT_EVENT_RISE;
+    }
+    return TILT_EVENT_NONE;
+}
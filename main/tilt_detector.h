@@ -0,0 +1,51 @@
+#ifndef TILT_DETECTOR_H_
+#define TILT_DETECTOR_H_
+
+#include <stdbool.h>
+
+#include "Fusion.h"
+
+/*
+ * Detector de inclinacao da guitarra (gesto de star power).
+ *
+ * Usa o vetor de gravidade estimado pelo AHRS, nao a aceleracao bruta:
+ * vibracao da palhetada nao muda a orientacao, entao nao dispara. O
+ * angulo do eixo X com a horizontal precisa passar de enter_deg por
+ * hold_ms seguidos para ativar e cair abaixo de exit_deg para rearmar
+ * (histerese). Enquanto a guitarra gira rapido (> max_rate_dps) a
+ * estimativa do AHRS atrasa, entao o tempo de hold nao conta.
+ *
+ * hold_ms precisa cobrir pelo menos duas amostras do pipeline mais lento
+ * (mpu6050_task, 100 ms): com uma so, uma unica leitura acima do limiar
+ * ja ativaria.
+ */
+
+typedef struct {
+    float enter_deg;
+    float exit_deg;
+    float hold_ms;
+    float max_rate_dps;
+} tilt_config_t;
+
+#define TILT_CONFIG_DEFAULT {.enter_deg = 50.0f, .exit_deg = 30.0f, .hold_ms = 200.0f, .max_rate_dps = 300.0f}
+
+typedef enum {
+    TILT_EVENT_NONE = 0,
+    TILT_EVENT_RISE, // entrou na inclinacao: ativar star power
+    TILT_EVENT_FALL, // voltou para a posicao normal
+} tilt_event_t;
+
+typedef struct {
+    tilt_config_t config;
+    bool active;
+    float held_ms;
+    float angle_deg; // ultimo angulo calculado, para debug
+} tilt_detector_t;
+
+void tilt_detector_init(tilt_detector_t *tilt, const tilt_config_t *config);
+
+// gravity: FusionAhrsGetGravity (unitario, no referencial do sensor)
+// gyroscope: graus/s; dt_s: tempo desde a ultima chamada
+tilt_event_t tilt_detector_update(tilt_detector_t *tilt, FusionVector gravity, FusionVector gyroscope, float dt_s);
+
+#endif // TILT_DETECTOR_H_
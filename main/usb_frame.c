@@ -0,0 +1,36 @@
+#include "usb_frame.h"
+
+#include "pico/stdlib.h"
+#include "pico/stdio_usb.h"
+
+static uint16_t frame_crc;
+
+uint16_t usb_frame_crc16(uint16_t crc, const uint8_t *data, size_t len) {
+    while (len--) {
+        crc ^= (uint16_t)(*data++) << 8;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+void usb_frame_write(const void *data, size_t len) {
+    frame_crc = usb_frame_crc16(frame_crc, data, len);
+    stdio_usb.out_chars(data, len);
+}
+
+void usb_frame_begin(uint8_t type, uint8_t version, uint16_t seq, uint16_t payload_len) {
+    uint8_t header[USB_FRAME_HEADER_LEN] = {USB_FRAME_MAGIC0, USB_FRAME_MAGIC1, type, version};
+    usb_frame_put_u16(header + 4, seq);
+    usb_frame_put_u16(header + 6, payload_len);
+
+    frame_crc = 0xFFFF;
+    usb_frame_write(header, sizeof(header));
+}
+
+void usb_frame_end(void) {
+    uint8_t crc[2];
+    usb_frame_put_u16(crc, frame_crc);
+    stdio_usb.out_chars((const char *)crc, sizeof(crc));
+}
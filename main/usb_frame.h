@@ -0,0 +1,46 @@
+#ifndef USB_FRAME_H_
+#define USB_FRAME_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Frame binario na USB CDC (little endian):
+ *
+ *   u8  magic[2]    0xA5 0x5A
+ *   u8  type
+ *   u8  version
+ *   u16 seq
+ *   u16 payload_len
+ *   u8  payload[payload_len]
+ *   u16 crc16     CRC-16/CCITT-FALSE do header + payload
+ *
+ * Os bytes vao direto para o driver USB (sem traducao CRLF e sem sair
+ * pela UART do stdio). Apenas uma task deve escrever frames.
+ */
+#define USB_FRAME_MAGIC0 0xA5
+#define USB_FRAME_MAGIC1 0x5A
+#define USB_FRAME_HEADER_LEN 8
+
+#define USB_FRAME_TYPE_STATS 0x01
+#define USB_FRAME_TYPE_TRACE 0x02
+#define USB_FRAME_TYPE_HEAP 0x03
+
+void usb_frame_begin(uint8_t type, uint8_t version, uint16_t seq, uint16_t payload_len);
+void usb_frame_write(const void *data, size_t len);
+void usb_frame_end(void);
+
+uint16_t usb_frame_crc16(uint16_t crc, const uint8_t *data, size_t len);
+
+static inline uint8_t *usb_frame_put_u16(uint8_t *p, uint16_t v) {
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+    return p + 2;
+}
+
+static inline uint8_t *usb_frame_put_u32(uint8_t *p, uint32_t v) {
+    p = usb_frame_put_u16(p, v & 0xFFFF);
+    return usb_frame_put_u16(p, v >> 16);
+}
+
+#endif // USB_FRAME_H_
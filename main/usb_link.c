@@ -0,0 +1,153 @@
+#include "usb_link.h"
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include "pico/stdlib.h"
+#include "pico/stdio_usb.h"
+
+#include <string.h>
+
+#include "rtos_stats.h"
+#include "usb_frame.h"
+#include "trace_recorder.h"
+#include "heap_pool.h"
+#include "app_signals.h"
+#include "rumble.h"
+
+#if TRACE_RECORDER_ENABLED
+#define TRACE_NAME_ENTRY_LEN (2 + TRACE_RECORDER_NAME_LEN)
+#define TRACE_MAX_NAMES (RTOS_STATS_MAX_TASKS + 8)
+
+static TaskStatus_t trace_tasks[RTOS_STATS_MAX_TASKS];
+static uint16_t trace_dump_seq;
+
+static void usb_trace_write_name(uint8_t kind, uint8_t id, const char *name) {
+    uint8_t entry[TRACE_NAME_ENTRY_LEN] = {kind, id};
+    strncpy((char *)entry + 2, name, TRACE_RECORDER_NAME_LEN);
+    usb_frame_write(entry, sizeof(entry));
+}
+
+static void usb_trace_dump(void) {
+    uint32_t overwritten;
+    uint32_t n_records = trace_recorder_freeze(&overwritten);
+    UBaseType_t n_tasks = uxTaskGetSystemState(trace_tasks, RTOS_STATS_MAX_TASKS, NULL);
+
+    uint32_t n_names = n_tasks;
+    uint8_t kind, id;
+    const char *name;
+    while (trace_recorder_get_name(n_names - n_tasks, &kind, &id, &name)) {
+        n_names++;
+    }
+
+    uint8_t summary[12];
+    uint8_t *p = usb_frame_put_u32(summary, time_us_32());
+    p = usb_frame_put_u32(p, overwritten);
+    p = usb_frame_put_u16(p, n_records);
+    *p++ = (uint8_t)n_names;
+    *p++ = 0;
+
+    usb_frame_begin(USB_FRAME_TYPE_TRACE, USB_TRACE_VERSION, trace_dump_seq++,
+                    sizeof(summary) + n_names * TRACE_NAME_ENTRY_LEN +
+                        n_records * sizeof(trace_record_t));
+    usb_frame_write(summary, sizeof(summary));
+
+    for (UBaseType_t i = 0; i < n_tasks; i++) {
+        usb_trace_write_name(TRACE_NAME_TASK, trace_tasks[i].xTaskNumber, trace_tasks[i].pcTaskName);
+    }
+    for (uint32_t i = 0; trace_recorder_get_name(i, &kind, &id, &name); i++) {
+        usb_trace_write_name(kind, id, name);
+    }
+    // trace_record_t ja esta no layout do frame (little endian, 8 bytes)
+    for (uint32_t i = 0; i < n_records; i++) {
+        usb_frame_write(trace_recorder_get(i), sizeof(trace_record_t));
+    }
+    usb_frame_end();
+
+    trace_recorder_resume();
+}
+#endif
+
+#if !RTOS_STATIC_ALLOCATION
+#define HEAP_CLASS_ENTRY_LEN 24
+
+static uint16_t heap_report_seq;
+
+static void usb_heap_report(void) {
+    size_t n_classes = heap_pool_class_count();
+
+    uint8_t summary[14];
+    uint8_t *p = usb_frame_put_u32(summary, xPortGetFreeHeapSize());
+    p = usb_frame_put_u32(p, xPortGetMinimumEverFreeHeapSize());
+    p = usb_frame_put_u32(p, heap_pool_wasted_bytes());
+    *p++ = (uint8_t)n_classes;
+    *p++ = 0;
+
+    usb_frame_begin(USB_FRAME_TYPE_HEAP, USB_HEAP_VERSION, heap_report_seq++,
+                    sizeof(summary) + n_classes * HEAP_CLASS_ENTRY_LEN);
+    usb_frame_write(summary, sizeof(summary));
+
+    for (size_t i = 0; i < n_classes; i++) {
+        heap_pool_class_stats_t s;
+        uint8_t entry[HEAP_CLASS_ENTRY_LEN];
+        heap_pool_get_class_stats(i, &s);
+
+        p = usb_frame_put_u32(entry, s.block_size);
+        p = usb_frame_put_u16(p, s.blocks);
+        p = usb_frame_put_u16(p, s.in_use);
+        p = usb_frame_put_u16(p, s.peak_in_use);
+        p = usb_frame_put_u16(p, s.spills);
+        p = usb_frame_put_u32(p, s.allocs);
+        p = usb_frame_put_u32(p, s.failures);
+        usb_frame_put_u32(p, s.requested);
+        usb_frame_write(entry, sizeof(entry));
+    }
+    usb_frame_end();
+}
+#endif
+
+void usb_link_task(void *p) {
+    TickType_t last_stats = xTaskGetTickCount();
+    bool host_present = false;
+
+    while (true) {
+        vTaskDelay(pdMS_TO_TICKS(USB_LINK_POLL_MS));
+
+        bool connected = stdio_usb_connected();
+        if (connected != host_present) {
+            host_present = connected;
+            if (connected) {
+                xEventGroupSetBits(app_signals_link_events(), LINK_USB_HOST);
+            } else {
+                xEventGroupClearBits(app_signals_link_events(), LINK_USB_HOST);
+            }
+        }
+        if (!connected) {
+            continue;
+        }
+
+        int cmd = getchar_timeout_us(0);
+#if TRACE_RECORDER_ENABLED
+        if (cmd == USB_CMD_TRACE_DUMP) {
+            usb_trace_dump();
+        }
+#endif
+#if !RTOS_STATIC_ALLOCATION
+        if (cmd == USB_CMD_HEAP_REPORT) {
+            usb_heap_report();
+        }
+#endif
+        if (cmd == USB_CMD_RUMBLE) {
+            int fx = getchar_timeout_us(USB_LINK_POLL_MS * 1000);
+            if (fx >= 0) {
+                rumble_play((rumble_fx_t)fx);
+            }
+        }
+
+        TickType_t now = xTaskGetTickCount();
+        if (now - last_stats >= pdMS_TO_TICKS(RTOS_STATS_PERIOD_MS)) {
+            last_stats = now;
+            rtos_stats_send();
+        }
+    }
+}
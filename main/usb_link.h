@@ -0,0 +1,42 @@
+#ifndef USB_LINK_H_
+#define USB_LINK_H_
+
+/*
+ * Task de diagnostico na USB CDC: envia o frame de estatisticas a cada
+ * RTOS_STATS_PERIOD_MS e atende comandos de 1 byte vindos do host.
+ */
+#define USB_LINK_POLL_MS 20
+
+#define USB_CMD_TRACE_DUMP 'T'
+#define USB_CMD_HEAP_REPORT 'H'
+#define USB_CMD_RUMBLE 'R' // seguido de 1 byte com o rumble_fx_t
+
+/*
+ * Payload do frame USB_FRAME_TYPE_TRACE:
+ *
+ *   u32 dump_time_us
+ *   u32 overwritten      registros perdidos por sobrescrita do ring
+ *   u16 n_records
+ *   u8  n_names
+ *   u8  pad
+ *   n_names x   { u8 kind, u8 id, char name[TRACE_RECORDER_NAME_LEN] }
+ *   n_records x { u32 timestamp_us, u8 type, u8 id, u16 arg }  (mais antigo primeiro)
+ */
+#define USB_TRACE_VERSION 1
+
+/*
+ * Payload do frame USB_FRAME_TYPE_HEAP (heap_pool.c, so com alocacao dinamica):
+ *
+ *   u32 free_bytes
+ *   u32 min_ever_free_bytes
+ *   u32 wasted_bytes     fragmentacao interna dos blocos em uso
+ *   u8  n_classes
+ *   u8  pad
+ *   n_classes x { u32 block_size, u16 blocks, u16 in_use, u16 peak_in_use,
+ *                 u16 spills, u32 allocs, u32 failures, u32 requested }
+ */
+#define USB_HEAP_VERSION 1
+
+void usb_link_task(void *p);
+
+#endif // USB_LINK_H_
@@ -0,0 +1,38 @@
+#include "whammy.h"
+
+#include <stdlib.h>
+
+void whammy_init(whammy_t *w, uint16_t raw_rest) {
+    w->rest = raw_rest;
+    w->max = raw_rest + WHAMMY_MIN_SPAN;
+    w->smoothed_q4 = (int32_t)raw_rest << 4;
+    w->reported = -1;
+}
+
+bool whammy_update(whammy_t *w, uint16_t raw, int *report) {
+    // EMA 1/4: ~40 ms de constante de tempo a 100 Hz
+    w->smoothed_q4 += (((int32_t)raw << 4) - w->smoothed_q4) >> 2;
+    int32_t value = w->smoothed_q4 >> 4;
+
+    if (value > w->max) {
+        w->max = value; // aprende o fim de curso
+    }
+
+    int32_t scaled = (value - w->rest) * WHAMMY_FULL_SCALE / (w->max - w->rest);
+    if (scaled < WHAMMY_DEADZONE) {
+        scaled = 0;
+    } else if (scaled > WHAMMY_FULL_SCALE) {
+        scaled = WHAMMY_FULL_SCALE;
+    }
+
+    // Repouso sempre e reportado, para o host nao ficar com whammy preso
+    bool changed = abs(scaled - w->reported) >= WHAMMY_REPORT_DELTA ||
+                   (scaled == 0 && w->reported != 0);
+    if (!changed) {
+        return false;
+    }
+
+    w->reported = scaled;
+    *report = scaled;
+    return true;
+}
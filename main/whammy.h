@@ -0,0 +1,37 @@
+#ifndef WHAMMY_H_
+#define WHAMMY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Whammy bar no ADC2 (GPIO28).
+ *
+ * Calibracao automatica: a posicao de repouso e medida no boot e o fim de
+ * curso e o maior valor ja visto (com um minimo de WHAMMY_MIN_SPAN). A
+ * leitura e suavizada por EMA e normalizada para 0..WHAMMY_FULL_SCALE.
+ * So e reportada quando muda mais que WHAMMY_REPORT_DELTA desde o ultimo
+ * envio (ou volta ao repouso), entao whammy parado nao gera trafego.
+ */
+
+#define WHAMMY_ADC_CHANNEL 2
+#define WHAMMY_PERIOD_MS 10
+#define WHAMMY_FULL_SCALE 1000
+#define WHAMMY_REPORT_DELTA 20 // 2% do curso
+#define WHAMMY_DEADZONE 30     // abaixo disso conta como repouso
+#define WHAMMY_MIN_SPAN 800    // contagens do ADC entre repouso e fim de curso
+
+typedef struct {
+    int32_t rest;        // contagens do ADC em repouso
+    int32_t max;         // maior contagem vista
+    int32_t smoothed_q4; // EMA em ponto fixo (x16)
+    int32_t reported;    // ultimo valor enviado (-1 = nenhum)
+} whammy_t;
+
+// Mede a posicao de repouso; chamar com a barra solta
+void whammy_init(whammy_t *w, uint16_t raw_rest);
+
+// Processa uma leitura; retorna true e o valor em *report se deve enviar
+bool whammy_update(whammy_t *w, uint16_t raw, int *report);
+
+#endif // WHAMMY_H_
@@ -2,9 +2,31 @@
 #include "font.h"
 
 inline static void swap(int32_t *a, int32_t *b) {
-    int32_t *t = a;
+    int32_t t = *a;
     *a = *b;
-    *b = *t;
+    *b = t;
+}
+
+// Framebuffers estaticos (frente e fundo): sem malloc no boot e sem risco
+// de fragmentacao. O byte extra no inicio e o mesmo reservado pela versao
+// com malloc.
+static uint8_t gfx_framebuffers[2][GFX_MONO_LCD_FRAMEBUFFER_SIZE + 1];
+
+static inline void gfx_mark_dirty(ssd1306_t *p, uint32_t page, uint32_t x0,
+                                  uint32_t x1) {
+    if (x0 < p->dirty_x0[page])
+        p->dirty_x0[page] = x0;
+    if (x1 > p->dirty_x1[page])
+        p->dirty_x1[page] = x1;
+}
+
+static inline void gfx_mark_clean(ssd1306_t *p, uint32_t page) {
+    p->dirty_x0[page] = UINT8_MAX;
+    p->dirty_x1[page] = 0;
+}
+
+static inline bool gfx_page_dirty(const ssd1306_t *p, uint32_t page) {
+    return p->dirty_x0[page] <= p->dirty_x1[page];
 }
 
 char gfx_init(ssd1306_t *p, uint16_t width, uint16_t height) {
@@ -13,83 +35,270 @@ char gfx_init(ssd1306_t *p, uint16_t width, uint16_t height) {
     p->pages = height / 8;
     p->bufsize = (p->pages) * (p->width);
 
-    // trocar remover malloc por alocação estática
-    if ((p->buffer = malloc(p->bufsize + 1)) == NULL) {
+    if (p->bufsize > GFX_MONO_LCD_FRAMEBUFFER_SIZE ||
+        p->pages > GFX_MONO_LCD_PAGES) {
         p->bufsize = 0;
         return false;
     }
 
-    memset(p->buffer, 0, p->bufsize + 1);
+    memset(gfx_framebuffers, 0, sizeof(gfx_framebuffers));
+    p->buffer = gfx_framebuffers[0] + 1;
+    p->front = gfx_framebuffers[1] + 1;
 
-    ++(p->buffer);
+    // GDDRAM e lixo no power-on: o primeiro show manda o frame inteiro
+    gfx_invalidate(p);
 
     return true;
 }
 
-inline void gfx_deinit(ssd1306_t *p) { free(p->buffer - 1); }
+void gfx_invalidate(ssd1306_t *p) {
+    for (uint32_t page = 0; page < p->pages; page++) {
+        p->dirty_x0[page] = 0;
+        p->dirty_x1[page] = p->width - 1;
+    }
+    p->front_valid = false;
+}
+
+inline void gfx_deinit(ssd1306_t *p) {
+    ssd1306_dma_wait();
+    p->buffer = NULL;
+    p->front = NULL;
+}
 
 void gfx_clear_buffer(ssd1306_t *p) {
-    memset(p->buffer, 0, p->bufsize + 1);
+    // Marca so o trecho aceso de cada pagina; o show ainda compara com o
+    // ultimo frame enviado, entao redesenhar o mesmo conteudo nao envia nada
+    for (uint32_t page = 0; page < p->pages; page++) {
+        uint8_t *row = p->buffer + page * p->width;
+        int32_t x0 = 0, x1 = p->width - 1;
+
+        while (x0 <= x1 && row[x0] == 0)
+            x0++;
+        while (x1 >= x0 && row[x1] == 0)
+            x1--;
+        if (x0 <= x1) {
+            gfx_mark_dirty(p, page, x0, x1);
+            memset(row + x0, 0, x1 - x0 + 1);
+        }
+    }
 }
 
 void gfx_clear_pixel(ssd1306_t *p, uint32_t x, uint32_t y) {
     if (x >= p->width || y >= p->height)
         return;
 
-    p->buffer[x + p->width * (y >> 3)] &= ~(0x1 << (y & 0x07));
+    uint8_t *byte = &p->buffer[x + p->width * (y >> 3)];
+    uint8_t mask = 0x1 << (y & 0x07);
+    if (*byte & mask) {
+        *byte &= ~mask;
+        gfx_mark_dirty(p, y >> 3, x, x);
+    }
 }
 
 void gfx_draw_pixel(ssd1306_t *p, uint32_t x, uint32_t y) {
     if (x >= p->width || y >= p->height)
         return;
 
-    p->buffer[x + p->width * (y >> 3)] |=
-        0x1 << (y & 0x07); // y>>3==y/8 && y&0x7==y%8
+    uint8_t *byte = &p->buffer[x + p->width * (y >> 3)]; // y>>3==y/8
+    uint8_t mask = 0x1 << (y & 0x07);                     // y&0x7==y%8
+    if (!(*byte & mask)) {
+        *byte |= mask;
+        gfx_mark_dirty(p, y >> 3, x, x);
+    }
+}
+
+// Preenche o retangulo [x0,x1] x [y0,y1] ja recortado: uma mascara de
+// bits por pagina, memset quando a pagina inteira da coluna e coberta.
+static void gfx_fill_clipped(ssd1306_t *p, int32_t x0, int32_t y0, int32_t x1,
+                             int32_t y1) {
+    uint32_t page0 = y0 >> 3, page1 = y1 >> 3;
+
+    for (uint32_t page = page0; page <= page1; page++) {
+        uint8_t mask = 0xFF;
+        if (page == page0)
+            mask &= 0xFF << (y0 & 7);
+        if (page == page1)
+            mask &= 0xFF >> (7 - (y1 & 7));
+
+        uint8_t *row = p->buffer + page * p->width;
+        if (mask == 0xFF) {
+            memset(row + x0, 0xFF, x1 - x0 + 1);
+        } else {
+            for (int32_t x = x0; x <= x1; x++)
+                row[x] |= mask;
+        }
+        gfx_mark_dirty(p, page, x0, x1);
+    }
+}
+
+// Recorta uma vez por primitiva; retorna false se nada fica visivel
+static bool gfx_clip_rect(const ssd1306_t *p, int32_t *x0, int32_t *y0,
+                          int32_t *x1, int32_t *y1) {
+    if (*x0 > *x1 || *y0 > *y1)
+        return false;
+    if (*x1 < 0 || *y1 < 0 || *x0 >= p->width || *y0 >= p->height)
+        return false;
+    if (*x0 < 0)
+        *x0 = 0;
+    if (*y0 < 0)
+        *y0 = 0;
+    if (*x1 >= p->width)
+        *x1 = p->width - 1;
+    if (*y1 >= p->height)
+        *y1 = p->height - 1;
+    return true;
+}
+
+void gfx_fill_rect(ssd1306_t *p, int32_t x, int32_t y, int32_t width,
+                   int32_t height) {
+    int32_t x0 = x, y0 = y, x1 = x + width - 1, y1 = y + height - 1;
+    if (gfx_clip_rect(p, &x0, &y0, &x1, &y1))
+        gfx_fill_clipped(p, x0, y0, x1, y1);
+}
+
+void gfx_draw_hline(ssd1306_t *p, int32_t x0, int32_t x1, int32_t y) {
+    if (x0 > x1)
+        swap(&x0, &x1);
+    int32_t y1 = y;
+    if (gfx_clip_rect(p, &x0, &y, &x1, &y1))
+        gfx_fill_clipped(p, x0, y, x1, y);
 }
 
+void gfx_draw_vline(ssd1306_t *p, int32_t x, int32_t y0, int32_t y1) {
+    if (y0 > y1)
+        swap(&y0, &y1);
+    int32_t x1 = x;
+    if (gfx_clip_rect(p, &x, &y0, &x1, &y1))
+        gfx_fill_clipped(p, x, y0, x, y1);
+}
+
+// Bresenham inteiro, todos os octantes
 void gfx_draw_line(ssd1306_t *p, int32_t x1, int32_t y1, int32_t x2,
                    int32_t y2) {
-    if (x1 > x2) {
-        swap(&x1, &x2);
-        swap(&y1, &y2);
+    if (y1 == y2) {
+        gfx_draw_hline(p, x1, x2, y1);
+        return;
     }
-
     if (x1 == x2) {
-        if (y1 > y2)
-            swap(&y1, &y2);
-        for (int32_t i = y1; i <= y2; ++i)
-            gfx_draw_pixel(p, x1, i);
+        gfx_draw_vline(p, x1, y1, y2);
         return;
     }
 
-    float m = (float)(y2 - y1) / (float)(x2 - x1);
+    // Caixa envolvente: fora da tela descarta; dentro dispensa checagem
+    int32_t bx0 = x1 < x2 ? x1 : x2, bx1 = x1 < x2 ? x2 : x1;
+    int32_t by0 = y1 < y2 ? y1 : y2, by1 = y1 < y2 ? y2 : y1;
+    if (bx1 < 0 || by1 < 0 || bx0 >= p->width || by0 >= p->height)
+        return;
+    bool inside = bx0 >= 0 && by0 >= 0 && bx1 < p->width && by1 < p->height;
+
+    int32_t dx = bx1 - bx0, dy = -(by1 - by0);
+    int32_t sx = x1 < x2 ? 1 : -1, sy = y1 < y2 ? 1 : -1;
+    int32_t err = dx + dy;
 
-    for (int32_t i = x1; i <= x2; ++i) {
-        float y = m * (float)(i - x1) + (float)y1;
-        gfx_draw_pixel(p, i, (uint32_t)y);
+    while (true) {
+        if (inside || ((uint32_t)x1 < p->width && (uint32_t)y1 < p->height)) {
+            uint8_t *byte = &p->buffer[x1 + p->width * (y1 >> 3)];
+            uint8_t mask = 0x1 << (y1 & 0x07);
+            if (!(*byte & mask)) {
+                *byte |= mask;
+                gfx_mark_dirty(p, y1 >> 3, x1, x1);
+            }
+        }
+        if (x1 == x2 && y1 == y2)
+            break;
+        int32_t e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x1 += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y1 += sy;
+        }
     }
 }
 
 void gfx_draw_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width,
                      uint32_t height) {
-    for (uint32_t i = 0; i < width; ++i)
-        for (uint32_t j = 0; j < height; ++j)
-            gfx_draw_pixel(p, x + i, y + j);
+    gfx_fill_rect(p, x, y, width, height);
 }
 
 void gfx_draw_empty_square(ssd1306_t *p, uint32_t x, uint32_t y,
                            uint32_t width, uint32_t height) {
-    gfx_draw_line(p, x, y, x + width, y);
-    gfx_draw_line(p, x, y + height, x + width, y + height);
-    gfx_draw_line(p, x, y, x, y + height);
-    gfx_draw_line(p, x + width, y, x + width, y + height);
+    gfx_draw_hline(p, x, x + width, y);
+    gfx_draw_hline(p, x, x + width, y + height);
+    gfx_draw_vline(p, x, y, y + height);
+    gfx_draw_vline(p, x + width, y, y + height);
 }
 
-void gfx_draw_char_with_font(ssd1306_t *p, uint32_t x, uint32_t y,
-                             uint32_t scale, const uint8_t *font, char c) {
-    if (c < font[3] || c > font[4])
+// Aplica a operacao em n colunas; shift > 0 desloca para baixo, < 0 para cima
+static void gfx_rop_span(uint8_t *dst, const uint8_t *src, uint32_t n,
+                         int32_t shift, uint8_t mask, gfx_rop_t rop) {
+    if (shift == 0 && mask == 0xFF && rop == GFX_ROP_COPY) {
+        memcpy(dst, src, n);
         return;
+    }
+
+#define GFX_SRC(i) ((uint8_t)(shift >= 0 ? src[i] << shift : src[i] >> -shift) & mask)
+    switch (rop) {
+    case GFX_ROP_COPY:
+        for (uint32_t i = 0; i < n; i++)
+            dst[i] = (dst[i] & ~mask) | GFX_SRC(i);
+        break;
+    case GFX_ROP_OR:
+        for (uint32_t i = 0; i < n; i++)
+            dst[i] |= GFX_SRC(i);
+        break;
+    case GFX_ROP_AND:
+        for (uint32_t i = 0; i < n; i++)
+            dst[i] &= GFX_SRC(i) | ~mask;
+        break;
+    case GFX_ROP_XOR:
+        for (uint32_t i = 0; i < n; i++)
+            dst[i] ^= GFX_SRC(i);
+        break;
+    }
+#undef GFX_SRC
+}
 
+void gfx_blit(ssd1306_t *p, int32_t x, int32_t y, const gfx_bitmap_t *bmp,
+              gfx_rop_t rop) {
+    int32_t x0 = x, y0 = y;
+    int32_t x1 = x + bmp->width - 1, y1 = y + bmp->height - 1;
+    if (!gfx_clip_rect(p, &x0, &y0, &x1, &y1))
+        return;
+
+    uint32_t n = x1 - x0 + 1;
+    uint32_t src_pages = (bmp->height + 7) >> 3;
+    int32_t shift = y & 7;
+    int32_t page = y >> 3; // floor, tambem para y negativo
+
+    for (uint32_t sp = 0; sp < src_pages; sp++, page++) {
+        const uint8_t *src = bmp->data + sp * bmp->width + (x0 - x);
+        uint8_t mask = 0xFF;
+        if (sp == src_pages - 1 && (bmp->height & 7))
+            mask >>= 8 - (bmp->height & 7);
+
+        // Parte de cima da pagina de origem cai na pagina `page`...
+        if (page >= 0 && page < p->pages) {
+            gfx_rop_span(p->buffer + page * p->width + x0, src, n, shift,
+                         mask << shift, rop);
+            gfx_mark_dirty(p, page, x0, x1);
+        }
+        // ...e o resto transborda para a seguinte
+        if (shift && page + 1 >= 0 && page + 1 < p->pages &&
+            (mask >> (8 - shift))) {
+            gfx_rop_span(p->buffer + (page + 1) * p->width + x0, src, n,
+                         shift - 8, mask >> (8 - shift), rop);
+            gfx_mark_dirty(p, page + 1, x0, x1);
+        }
+    }
+}
+
+// Caminho generico (fonte alta ou larga demais para o blitter): um
+// retangulo por bit aceso
+static void gfx_draw_char_slow(ssd1306_t *p, uint32_t x, uint32_t y,
+                               uint32_t scale, const uint8_t *font, char c) {
     uint32_t parts_per_line = (font[0] >> 3) + ((font[0] & 7) > 0);
     for (uint8_t w = 0; w < font[1]; ++w) { // width
         uint32_t pp =
@@ -108,6 +317,102 @@ void gfx_draw_char_with_font(ssd1306_t *p, uint32_t x, uint32_t y,
     }
 }
 
+// Coluna w do glifo como bits verticais (bit 0 = linha de cima)
+static uint32_t gfx_glyph_source_column(const uint8_t *font, char c, uint32_t w) {
+    uint32_t parts_per_line = (font[0] >> 3) + ((font[0] & 7) > 0);
+    uint32_t pp = (c - font[3]) * font[1] * parts_per_line + w * parts_per_line + 5;
+    uint32_t bits = 0;
+
+    for (uint32_t lp = 0; lp < parts_per_line; ++lp)
+        bits |= (uint32_t)font[pp + lp] << (lp << 3);
+    return bits;
+}
+
+// Estica os bits na vertical: cada bit vira `scale` bits
+static uint32_t gfx_scale_column(uint32_t bits, uint32_t scale) {
+    uint32_t out = 0;
+    uint32_t run = (1u << scale) - 1;
+
+    for (uint32_t i = 0; bits; i++, bits >>= 1) {
+        if (bits & 1)
+            out |= run << (i * scale);
+    }
+    return out;
+}
+
+// Glifos ja escalados (2x, 3x...): mapeamento direto por caractere/escala
+typedef struct {
+    const uint8_t *font;
+    char c;
+    uint8_t scale;
+    uint32_t cols[GFX_GLYPH_MAX_WIDTH];
+} gfx_glyph_t;
+
+static gfx_glyph_t gfx_glyph_cache[GFX_GLYPH_CACHE_SIZE];
+
+static const uint32_t *gfx_glyph_columns(const uint8_t *font, char c,
+                                         uint32_t scale, uint32_t *tmp) {
+    if (scale == 1) {
+        for (uint32_t w = 0; w < font[1]; ++w)
+            tmp[w] = gfx_glyph_source_column(font, c, w);
+        return tmp;
+    }
+
+    gfx_glyph_t *g = &gfx_glyph_cache[((uint8_t)c + scale * 7) % GFX_GLYPH_CACHE_SIZE];
+    if (g->font != font || g->c != c || g->scale != scale) {
+        for (uint32_t w = 0; w < font[1]; ++w)
+            g->cols[w] = gfx_scale_column(gfx_glyph_source_column(font, c, w), scale);
+        g->font = font;
+        g->c = c;
+        g->scale = scale;
+    }
+    return g->cols;
+}
+
+// OR de uma coluna de ate 32 bits na pagina, deslocada por y & 7
+static void gfx_or_column(ssd1306_t *p, uint32_t x, int32_t y, uint32_t bits) {
+    int32_t page = y >> 3;
+    uint32_t shift = y & 7;
+    uint32_t lo = bits << shift;
+    uint32_t hi = shift ? bits >> (32 - shift) : 0;
+
+    for (uint32_t i = 0; i < 5; i++, page++) {
+        uint8_t byte = i < 4 ? lo >> (i << 3) : hi;
+        if (byte && page >= 0 && page < p->pages)
+            p->buffer[page * p->width + x] |= byte;
+    }
+}
+
+void gfx_draw_char_with_font(ssd1306_t *p, uint32_t x, uint32_t y,
+                             uint32_t scale, const uint8_t *font, char c) {
+    if (c < font[3] || c > font[4])
+        return;
+
+    uint32_t width = font[1] * scale;
+    uint32_t height = font[0] * scale;
+    if (font[1] > GFX_GLYPH_MAX_WIDTH || height > 32 || scale == 0) {
+        gfx_draw_char_slow(p, x, y, scale, font, c);
+        return;
+    }
+
+    // Recorte uma vez por glifo
+    if (x >= p->width || y >= p->height)
+        return;
+    uint32_t x_end = x + width > p->width ? p->width : x + width;
+
+    uint32_t tmp[GFX_GLYPH_MAX_WIDTH];
+    const uint32_t *cols = gfx_glyph_columns(font, c, scale, tmp);
+
+    for (uint32_t cx = x; cx < x_end; ++cx)
+        gfx_or_column(p, cx, y, cols[(cx - x) / scale]);
+
+    uint32_t page1 = (y + height - 1) >> 3;
+    if (page1 >= p->pages)
+        page1 = p->pages - 1;
+    for (uint32_t page = y >> 3; page <= page1; ++page)
+        gfx_mark_dirty(p, page, x, x_end - 1);
+}
+
 void gfx_draw_string_with_font(ssd1306_t *p, uint32_t x, uint32_t y,
                                uint32_t scale, const uint8_t *font,
                                const char *s) {
@@ -126,10 +431,82 @@ void gfx_draw_string(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale,
     gfx_draw_string_with_font(p, x, y, scale, font_8x5, s);
 }
 
-void gfx_show(ssd1306_t *p) {
-    for (uint8_t page = 0; page < p->pages; page++) {
-        ssd1306_set_page_address(page);
-        ssd1306_set_column_address(0);
-        ssd1306_put_page(p->buffer + (page * p->width), page, 0, p->width);
+// Estreita o trecho sujo da pagina ao que de fato difere do ultimo envio
+static bool gfx_diff_span(ssd1306_t *p, uint32_t page, uint32_t *x0,
+                          uint32_t *x1) {
+    *x0 = p->dirty_x0[page];
+    *x1 = p->dirty_x1[page];
+    if (*x0 > *x1)
+        return false;
+    if (!p->front_valid)
+        return true;
+
+    const uint8_t *row = p->buffer + page * p->width;
+    const uint8_t *sent = p->front + page * p->width;
+    while (*x0 <= *x1 && row[*x0] == sent[*x0])
+        (*x0)++;
+    while (*x1 >= *x0 && row[*x1] == sent[*x1])
+        (*x1)--;
+    return *x0 <= *x1;
+}
+
+bool gfx_show(ssd1306_t *p) {
+    ssd1306_window_t windows[SSD1306_MAX_WINDOWS];
+    size_t count = 0;
+    uint32_t page = 0;
+
+    // O front ainda pode estar saindo pelo SPI
+    ssd1306_dma_wait();
+
+    while (page < p->pages) {
+        uint32_t x0, x1;
+        if (!gfx_diff_span(p, page, &x0, &x1)) {
+            gfx_mark_clean(p, page);
+            page++;
+            continue;
+        }
+
+        // Paginas seguidas com a largura toda viram uma so janela
+        uint32_t last = page;
+        if (x0 == 0 && x1 == p->width - 1u) {
+            while (last + 1 < p->pages && p->dirty_x0[last + 1] == 0 &&
+                   p->dirty_x1[last + 1] == p->width - 1u)
+                last++;
+        }
+
+        size_t offset = page * p->width + x0;
+        windows[count++] = (ssd1306_window_t){
+            .data = p->buffer + offset,
+            .len = (last - page) * p->width + (x1 - x0 + 1),
+            .col0 = x0,
+            .col1 = x1,
+            .page0 = page,
+            .page1 = last,
+        };
+
+        for (uint32_t i = page; i <= last; i++)
+            gfx_mark_clean(p, i);
+        page = last + 1;
+    }
+
+    // Troca: o frame desenhado vira o front que o DMA vai ler
+    uint8_t *sent = p->buffer;
+    p->buffer = p->front;
+    p->front = sent;
+
+    // O novo fundo tem o frame anterior; copia so os trechos que mudaram
+    // para que o desenho incremental continue de onde parou. Se o front
+    // antigo nao era confiavel, copia tudo.
+    if (!p->front_valid) {
+        memcpy(p->buffer, p->front, p->bufsize);
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            size_t offset = windows[i].data - p->front;
+            memcpy(p->buffer + offset, p->front + offset, windows[i].len);
+        }
     }
+    p->front_valid = true;
+
+    ssd1306_dma_flush_windows(windows, count);
+    return count > 0;
 }
@@ -4,21 +4,63 @@
 #include "ssd1306.h"
 #include <string.h>
 
+// Text blitter limits; larger fonts fall back to per-pixel rectangles
+#define GFX_GLYPH_MAX_WIDTH 8
+#define GFX_GLYPH_CACHE_SIZE 16 // pre-scaled glyphs (scale >= 2)
+
 typedef struct {
     uint8_t width;     /**< width of display */
     uint8_t height;    /**< height of display */
     uint8_t pages;     /**< stores pages of display (calculated on initialization*/
     bool external_vcc; /**< whether display uses external vcc */
-    uint8_t *buffer;   /**< display buffer */
+    uint8_t *buffer;   /**< back buffer, where drawing happens */
+    uint8_t *front;    /**< last frame handed to the DMA flush */
     size_t bufsize;    /**< buffer size */
+    uint8_t dirty_x0[GFX_MONO_LCD_PAGES]; /**< first changed column per page */
+    uint8_t dirty_x1[GFX_MONO_LCD_PAGES]; /**< last changed column (x0 > x1: clean) */
+    bool front_valid;  /**< front buffer matches the panel GDDRAM */
 } ssd1306_t;
 
+// Raster ops for gfx_blit; bits outside the bitmap are never touched
+typedef enum {
+    GFX_ROP_COPY, // replace
+    GFX_ROP_OR,   // set where the bitmap is 1
+    GFX_ROP_AND,  // clear where the bitmap is 0
+    GFX_ROP_XOR,  // invert where the bitmap is 1
+} gfx_rop_t;
+
+// 1-bpp bitmap in panel layout: ceil(height / 8) rows of `width` column
+// bytes, LSB on top (same as the fonts). Keep data `const` so it stays in
+// flash.
+typedef struct {
+    uint8_t width;
+    uint8_t height;
+    const uint8_t *data;
+} gfx_bitmap_t;
+
 char gfx_init(ssd1306_t *p, uint16_t width, uint16_t height);
 void gfx_clear_buffer(ssd1306_t *p);
-void gfx_show(ssd1306_t *p);
+// Swaps front/back and starts an asynchronous DMA flush of only the changed
+// column span of each page (diffed against the previous front); full-width
+// runs of pages go out as one window. Drawing the next frame can start
+// right away; a second gfx_show waits for the previous flush. Returns true
+// when a flush was started; its completion is then reported through
+// ssd1306_dma_set_done_callback (nothing changed: false, no callback).
+bool gfx_show(ssd1306_t *p);
+// Marks the whole frame for the next gfx_show (e.g. after a panel reset)
+void gfx_invalidate(ssd1306_t *p);
 void gfx_draw_line(ssd1306_t *p, int32_t x1, int32_t y1, int32_t x2,
                    int32_t y2);
 void gfx_draw_pixel(ssd1306_t *p, uint32_t x, uint32_t y);
+void gfx_draw_hline(ssd1306_t *p, int32_t x0, int32_t x1, int32_t y);
+void gfx_draw_vline(ssd1306_t *p, int32_t x, int32_t y0, int32_t y1);
+// Clipped once, then written a page byte (or memset) at a time
+void gfx_fill_rect(ssd1306_t *p, int32_t x, int32_t y, int32_t width,
+                   int32_t height);
+// Clipped once; page-aligned y copies whole bytes, other offsets are
+// shifted across two pages
+void gfx_blit(ssd1306_t *p, int32_t x, int32_t y, const gfx_bitmap_t *bmp,
+              gfx_rop_t rop);
 void gfx_draw_string(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale,
                      const char *s);
 void gfx_draw_string_with_font(ssd1306_t *p, uint32_t x, uint32_t y,
@@ -1,5 +1,26 @@
 #include "ssd1306.h"
 
+#include <string.h>
+
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+
+static int ssd1306_dma_chan = -1;    // TX: buffer -> SPI
+static int ssd1306_dma_rx_chan = -1; // RX: SPI -> sink, ends each burst
+static volatile bool ssd1306_dma_active;
+static bool ssd1306_dma_in_data;     // current window phase: commands or data
+static uint8_t ssd1306_window_cmds[6];
+static uint8_t ssd1306_rx_sink;
+
+static ssd1306_window_t ssd1306_windows[SSD1306_MAX_WINDOWS];
+static size_t ssd1306_window_count;
+static size_t ssd1306_window_next;
+static ssd1306_flush_done_t ssd1306_done_callback;
+static void *ssd1306_done_arg;
+
+static void ssd1306_dma_init(void);
+static void ssd1306_spi_burst(bool data, const uint8_t *buf, size_t len);
+
 inline void spi_cs_select(void) {
     asm volatile("nop \n nop \n nop");
     gpio_put(PIN_CS, 0); // Active low
@@ -21,8 +42,11 @@ void ssd1306_set_display_start_line_address(uint8_t address) {
 void ssd1306_set_column_address(uint8_t address) {
     // Make sure the address is 7 bits
     address &= 0x7F;
-    ssd1306_write_command(SSD1306_CMD_COL_ADD_SET_MSB(address >> 4));
-    ssd1306_write_command(SSD1306_CMD_COL_ADD_SET_LSB(address & 0x0F));
+    const uint8_t cmds[] = {
+        SSD1306_CMD_COL_ADD_SET_MSB(address >> 4),
+        SSD1306_CMD_COL_ADD_SET_LSB(address & 0x0F),
+    };
+    ssd1306_write_commands(cmds, sizeof(cmds));
 }
 
 void ssd1306_set_page_address(uint8_t address) {
@@ -40,8 +64,8 @@ void ssd1306_display_off(void) {
 }
 
 uint8_t ssd1306_set_contrast(uint8_t contrast) {
-    ssd1306_write_command(SSD1306_CMD_SET_CONTRAST_CONTROL_FOR_BANK0);
-    ssd1306_write_command(contrast);
+    const uint8_t cmds[] = {SSD1306_CMD_SET_CONTRAST_CONTROL_FOR_BANK0, contrast};
+    ssd1306_write_commands(cmds, sizeof(cmds));
     return contrast;
 }
 
@@ -53,12 +77,20 @@ void ssd1306_display_invert_disable(void) {
     ssd1306_write_command(SSD1306_CMD_SET_NORMAL_DISPLAY);
 }
 
+// Page + column in one command burst (page/column pointer, page addressing)
+static void ssd1306_set_address(uint8_t page, uint8_t column) {
+    column &= 0x7F;
+    const uint8_t cmds[] = {
+        SSD1306_CMD_SET_PAGE_START_ADDRESS(page & 0x0F),
+        SSD1306_CMD_COL_ADD_SET_MSB(column >> 4),
+        SSD1306_CMD_COL_ADD_SET_LSB(column & 0x0F),
+    };
+    ssd1306_write_commands(cmds, sizeof(cmds));
+}
+
 void gfx_mono_ssd1306_put_byte(uint8_t page, uint8_t column, uint8_t data,
                                bool force) {
-
-    ssd1306_set_page_address(page);
-    ssd1306_set_column_address(column);
-
+    ssd1306_set_address(page, column);
     ssd1306_write_data(data);
 }
 
@@ -78,11 +110,90 @@ void ssd1306_interface_init(void) {
     gpio_set_dir(PIN_CS, GPIO_OUT);
     gpio_put(PIN_CS, 1);
 
-    // spi_init(SPI_PORT, 1000000); 10 * 1024 * 1024
-    spi_init(SPI_PORT, 2000000);
+    spi_init(SPI_PORT, SSD1306_SPI_BAUD);
     spi_set_format(SPI_PORT, 8, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
     gpio_set_function(PIN_SCK, GPIO_FUNC_SPI);
     gpio_set_function(PIN_TX, GPIO_FUNC_SPI);
+
+    ssd1306_dma_init();
+}
+
+// One DMA burst with D/C already set. The RX channel takes the same number
+// of bytes back from the SPI; a byte is only received once it has been
+// fully clocked out, so the RX completion interrupt marks the moment D/C
+// and CS may change, with no wait on the shifter.
+static void ssd1306_dma_burst(const uint8_t *buf, size_t len) {
+    dma_channel_transfer_to_buffer_now(ssd1306_dma_rx_chan, &ssd1306_rx_sink, len);
+    dma_channel_transfer_from_buffer_now(ssd1306_dma_chan, buf, len);
+}
+
+// Address window commands through DMA; the data follows from the interrupt.
+// CS is already asserted; runs in task context for the first window and in
+// the DMA interrupt for the following ones.
+static void ssd1306_dma_start_window(const ssd1306_window_t *w) {
+    ssd1306_window_cmds[0] = SSD1306_CMD_SET_COLUMN_ADDRESS;
+    ssd1306_window_cmds[1] = w->col0;
+    ssd1306_window_cmds[2] = w->col1;
+    ssd1306_window_cmds[3] = SSD1306_CMD_SET_PAGE_ADDRESS;
+    ssd1306_window_cmds[4] = w->page0;
+    ssd1306_window_cmds[5] = w->page1;
+
+    ssd1306_dma_in_data = false;
+    gpio_put(SSD1306_DATA_CMD_SEL, 0);
+    ssd1306_dma_burst(ssd1306_window_cmds, sizeof(ssd1306_window_cmds));
+}
+
+// The last byte of a burst has left the shifter: commands are followed by
+// the window data, data by the next window, the last window releases CS.
+// Only register writes here; nothing waits on the SPI.
+static void ssd1306_dma_isr(void) {
+    if (!dma_channel_get_irq1_status(ssd1306_dma_rx_chan)) {
+        return;
+    }
+    dma_channel_acknowledge_irq1(ssd1306_dma_rx_chan);
+
+    if (!ssd1306_dma_in_data) {
+        const ssd1306_window_t *w = &ssd1306_windows[ssd1306_window_next];
+        ssd1306_dma_in_data = true;
+        gpio_put(SSD1306_DATA_CMD_SEL, 1);
+        ssd1306_dma_burst(w->data, w->len);
+        return;
+    }
+
+    if (++ssd1306_window_next < ssd1306_window_count) {
+        ssd1306_dma_start_window(&ssd1306_windows[ssd1306_window_next]);
+        return;
+    }
+    spi_cs_deselect();
+
+    ssd1306_dma_active = false;
+    if (ssd1306_done_callback) {
+        ssd1306_done_callback(ssd1306_done_arg);
+    }
+}
+
+static void ssd1306_dma_init(void) {
+    ssd1306_dma_chan = dma_claim_unused_channel(true);
+
+    dma_channel_config cfg = dma_channel_get_default_config(ssd1306_dma_chan);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_8);
+    channel_config_set_read_increment(&cfg, true);
+    channel_config_set_write_increment(&cfg, false);
+    channel_config_set_dreq(&cfg, spi_get_dreq(SPI_PORT, true));
+    dma_channel_configure(ssd1306_dma_chan, &cfg, &spi_get_hw(SPI_PORT)->dr, NULL, 0, false);
+
+    ssd1306_dma_rx_chan = dma_claim_unused_channel(true);
+    cfg = dma_channel_get_default_config(ssd1306_dma_rx_chan);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_8);
+    channel_config_set_read_increment(&cfg, false);
+    channel_config_set_write_increment(&cfg, false);
+    channel_config_set_dreq(&cfg, spi_get_dreq(SPI_PORT, false));
+    dma_channel_configure(ssd1306_dma_rx_chan, &cfg, &ssd1306_rx_sink, &spi_get_hw(SPI_PORT)->dr, 0,
+                          false);
+
+    dma_channel_set_irq1_enabled(ssd1306_dma_rx_chan, true);
+    irq_add_shared_handler(DMA_IRQ_1, ssd1306_dma_isr, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
 }
 
 void ssd1306_hard_reset(void) {
@@ -92,82 +203,122 @@ void ssd1306_hard_reset(void) {
     busy_wait_us(SSD1306_LATENCY);
 }
 
-void ssd1306_write_command(uint8_t command) {
-    gpio_put(SSD1306_DATA_CMD_SEL, 0);
+// One burst with D/C fixed. spi_write_blocking returns only after the
+// last bit left the shifter, so D/C and CS can change right after it and
+// no extra settle delay is needed.
+static void ssd1306_spi_burst(bool data, const uint8_t *buf, size_t len) {
+    gpio_put(SSD1306_DATA_CMD_SEL, data);
+    spi_write_blocking(SPI_PORT, buf, len);
+}
+
+void ssd1306_write_commands(const uint8_t *cmds, size_t len) {
+    ssd1306_dma_wait();
     spi_cs_select();
-    spi_write_blocking(SPI_PORT, &command, 1);
-    // spi_cs_deselect();
-    busy_wait_us_32(4);
+    ssd1306_spi_burst(false, cmds, len);
+    spi_cs_deselect();
 }
 
-void ssd1306_write_data(uint8_t data) {
-    gpio_put(SSD1306_DATA_CMD_SEL, 1);
+void ssd1306_write_data_buf(const uint8_t *data, size_t len) {
+    ssd1306_dma_wait();
     spi_cs_select();
-    spi_write_blocking(SPI_PORT, &data, 1);
-    // spi_cs_deselect();
-    busy_wait_us_32(4);
+    ssd1306_spi_burst(true, data, len);
+    spi_cs_deselect();
 }
 
+void ssd1306_write_command(uint8_t command) {
+    ssd1306_write_commands(&command, 1);
+}
+
+void ssd1306_write_data(uint8_t data) { ssd1306_write_data_buf(&data, 1); }
+
 void ssd1306_put_page(uint8_t *data, uint8_t page, uint8_t column,
                       uint8_t width) {
-    ssd1306_set_page_address(page);
-    ssd1306_set_column_address(column);
+    ssd1306_set_address(page, column);
+    ssd1306_write_data_buf(data, width);
+}
 
-    do {
-        ssd1306_write_data(*data++);
-    } while (--width);
+bool ssd1306_dma_busy(void) { return ssd1306_dma_active; }
+
+void ssd1306_dma_wait(void) {
+    while (ssd1306_dma_active) {
+        tight_loop_contents();
+    }
 }
 
-void ssd1306_init(void) {
-    ssd1306_interface_init();
-    ssd1306_hard_reset();
-    // 1/32 Duty (0x0F~0x3F)
-    ssd1306_write_command(SSD1306_CMD_SET_MULTIPLEX_RATIO);
-    ssd1306_write_command(0x1F);
+void ssd1306_dma_set_done_callback(ssd1306_flush_done_t callback, void *arg) {
+    ssd1306_done_callback = callback;
+    ssd1306_done_arg = arg;
+}
 
-    // Shift Mapping RAM Counter (0x00~0x3F)
-    ssd1306_write_command(SSD1306_CMD_SET_DISPLAY_OFFSET);
-    ssd1306_write_command(0x00);
+void ssd1306_dma_flush_windows(const ssd1306_window_t *windows, size_t count) {
+    ssd1306_dma_wait();
+    if (count == 0) {
+        return;
+    }
+    if (count > SSD1306_MAX_WINDOWS) {
+        count = SSD1306_MAX_WINDOWS;
+    }
+
+    memcpy(ssd1306_windows, windows, count * sizeof(*windows));
+    ssd1306_window_count = count;
+    ssd1306_window_next = 0;
+
+    // The RX channel counts bytes from an empty FIFO
+    while (spi_is_readable(SPI_PORT)) {
+        (void)spi_get_hw(SPI_PORT)->dr;
+    }
+    spi_get_hw(SPI_PORT)->icr = SPI_SSPICR_RORIC_BITS;
+
+    // Horizontal addressing (set in ssd1306_init): each window wraps column
+    // by column and page by page, so one burst covers a whole window.
+    spi_cs_select();
+    ssd1306_dma_active = true;
+    ssd1306_dma_start_window(&ssd1306_windows[0]);
+}
 
-    // Set Mapping RAM Display Start Line (0x00~0x3F)
-    ssd1306_write_command(SSD1306_CMD_SET_DISPLAY_START_LINE(0x40));
+void ssd1306_dma_flush_window(const uint8_t *data, size_t len, uint8_t col0,
+                              uint8_t col1, uint8_t page0, uint8_t page1) {
+    const ssd1306_window_t w = {data, len, col0, col1, page0, page1};
+    ssd1306_dma_flush_windows(&w, 1);
+}
 
-    // Set Mapping RAM Display Start Line (0x00~0x3F)
-    ssd1306_write_command(SSD1306_CMD_SET_MEMORY_ADDRESSING_MODE);
-    ssd1306_write_command(0);
+void ssd1306_dma_flush(const uint8_t *data, size_t len, uint8_t pages) {
+    ssd1306_dma_flush_window(data, len, 0, GFX_MONO_LCD_WIDTH - 1, 0, pages - 1);
+}
 
+// Power-up sequence, sent as a single command burst
+static const uint8_t ssd1306_init_cmds[] = {
+    // 1/32 Duty (0x0F~0x3F)
+    SSD1306_CMD_SET_MULTIPLEX_RATIO, 0x1F,
+    // Shift Mapping RAM Counter (0x00~0x3F)
+    SSD1306_CMD_SET_DISPLAY_OFFSET, 0x00,
+    // Set Mapping RAM Display Start Line (0x00~0x3F)
+    SSD1306_CMD_SET_DISPLAY_START_LINE(0x40),
+    // Horizontal addressing, used by the DMA windows
+    SSD1306_CMD_SET_MEMORY_ADDRESSING_MODE, 0,
     // Set Column Address 0 Mapped to SEG0
-    ssd1306_write_command(SSD1306_CMD_SET_SEGMENT_RE_MAP_COL127_SEG0);
-
+    SSD1306_CMD_SET_SEGMENT_RE_MAP_COL127_SEG0,
     // Set COM/Row Scan Scan from COM63 to 0
-    ssd1306_write_command(0xC8);
-
+    SSD1306_CMD_SET_COM_OUTPUT_SCAN_DOWN,
     // Set COM Pins hardware configuration
-    ssd1306_write_command(SSD1306_CMD_SET_COM_PINS);
-    ssd1306_write_command(0x02);
-
-    ssd1306_set_contrast(0x8F);
-
+    SSD1306_CMD_SET_COM_PINS, 0x02,
+    SSD1306_CMD_SET_CONTRAST_CONTROL_FOR_BANK0, 0x8F,
     // Disable Entire display On
-    ssd1306_write_command(SSD1306_CMD_ENTIRE_DISPLAY_AND_GDDRAM_ON);
-
-    ssd1306_display_invert_disable();
-
+    SSD1306_CMD_ENTIRE_DISPLAY_AND_GDDRAM_ON,
+    SSD1306_CMD_SET_NORMAL_DISPLAY,
     // Set Display Clock Divide Ratio / Oscillator Frequency (Default => 0x80)
-    ssd1306_write_command(SSD1306_CMD_SET_DISPLAY_CLOCK_DIVIDE_RATIO);
-    ssd1306_write_command(0x80);
-
+    SSD1306_CMD_SET_DISPLAY_CLOCK_DIVIDE_RATIO, 0x80,
     // Enable charge pump regulator
-    ssd1306_write_command(SSD1306_CMD_SET_CHARGE_PUMP_SETTING);
-    ssd1306_write_command(0x14);
-
+    SSD1306_CMD_SET_CHARGE_PUMP_SETTING, 0x14,
     // Set VCOMH Deselect Level
-    ssd1306_write_command(SSD1306_CMD_SET_VCOMH_DESELECT_LEVEL);
-    ssd1306_write_command(0x40); // Default => 0x20 (0.77*VCC)
-
+    SSD1306_CMD_SET_VCOMH_DESELECT_LEVEL, 0x40, // Default => 0x20 (0.77*VCC)
     // Set Pre-Charge as 15 Clocks & Discharge as 1 Clock
-    ssd1306_write_command(SSD1306_CMD_SET_PRE_CHARGE_PERIOD);
-    ssd1306_write_command(0xF1);
+    SSD1306_CMD_SET_PRE_CHARGE_PERIOD, 0xF1,
+    SSD1306_CMD_SET_DISPLAY_ON,
+};
 
-    ssd1306_display_on();
+void ssd1306_init(void) {
+    ssd1306_interface_init();
+    ssd1306_hard_reset();
+    ssd1306_write_commands(ssd1306_init_cmds, sizeof(ssd1306_init_cmds));
 }
@@ -47,9 +47,11 @@
 
 #define PIN_SCK 10
 #define PIN_TX 11
-#define PIN_CS 9
+#define PIN_CS 13 // GPIO 9 is the MPU6050 SCL
 #define SPI_PORT spi1
 #define SSD1306_LATENCY 10
+// SSD1306 serial clock cycle is 100 ns min (datasheet tcycle), i.e. 10 MHz
+#define SSD1306_SPI_BAUD 10000000
 
 inline void spi_cs_select(void);
 inline void spi_cs_deselect(void);
@@ -68,6 +70,41 @@ void ssd1306_interface_init(void);
 void ssd1306_hard_reset(void);
 void ssd1306_write_command(uint8_t command);
 void ssd1306_write_data(uint8_t data);
+// Whole command list (or data run) in one CS assertion with D/C held
+void ssd1306_write_commands(const uint8_t *cmds, size_t len);
+void ssd1306_write_data_buf(const uint8_t *data, size_t len);
 void ssd1306_init(void);
 
+/*
+ * Frame flush over DMA: sets the column/page window once and streams `len`
+ * bytes of GDDRAM data in a single CS assertion. Returns immediately; the
+ * buffer must stay untouched until ssd1306_dma_busy() is false. Any command
+ * or data write waits for a pending flush first.
+ */
+void ssd1306_dma_flush(const uint8_t *data, size_t len, uint8_t pages);
+// Same, for the window columns col0..col1 x pages page0..page1 (inclusive)
+void ssd1306_dma_flush_window(const uint8_t *data, size_t len, uint8_t col0,
+                              uint8_t col1, uint8_t page0, uint8_t page1);
+
+typedef struct {
+    const uint8_t *data;
+    uint16_t len;
+    uint8_t col0, col1;
+    uint8_t page0, page1;
+} ssd1306_window_t;
+
+#define SSD1306_MAX_WINDOWS GFX_MONO_LCD_PAGES
+
+/*
+ * Queues up to SSD1306_MAX_WINDOWS windows and sends them back to back
+ * from the DMA interrupt (the window list is copied, the data is not).
+ * The done callback runs in interrupt context after the last byte.
+ */
+void ssd1306_dma_flush_windows(const ssd1306_window_t *windows, size_t count);
+
+typedef void (*ssd1306_flush_done_t)(void *arg);
+void ssd1306_dma_set_done_callback(ssd1306_flush_done_t callback, void *arg);
+bool ssd1306_dma_busy(void);
+void ssd1306_dma_wait(void);
+
 #endif // SSD1306_H
@@ -15,6 +15,11 @@ pyautogui.FAILSAFE = False
 alpha = 0.2       # suavização exponencial (0.1 - 0.3)
 sensitivity = 0.05 # sensibilidade (0.0 - 1.0; <1 reduz movimento)
 smoothed = {0: 0.0, 1: 0.0}
+# Whammy (eixo 3, 0..1000): segura uma tecla enquanto a barra esta
+# empurrada; no Clone Hero, associar a whammy a esta tecla
+WHAMMY_KEY = 'h'
+WHAMMY_PRESS = 300   # aperta acima disso
+WHAMMY_RELEASE = 150 # solta abaixo disso (histerese)
 keys_pressed = set()
 
 # Buffer de bytes serial
@@ -22,12 +27,18 @@ data_buffer = bytearray()
 
 # Move o mouse aplicando filtro exponencial e sensibilidade
 def move_mouse(axis, raw_value):
+    if axis == 3:
+        if raw_value >= WHAMMY_PRESS and WHAMMY_KEY not in keys_pressed:
+            pyautogui.keyDown(WHAMMY_KEY)
+            keys_pressed.add(WHAMMY_KEY)
+        elif raw_value <= WHAMMY_RELEASE and WHAMMY_KEY in keys_pressed:
+            pyautogui.keyUp(WHAMMY_KEY)
+            keys_pressed.remove(WHAMMY_KEY)
+        return
     if axis == 2:
-            pyautogui.keyDown('space')
+            # o controle manda um unico evento por inclinacao
+            pyautogui.press('space')
             print("PRESSIONADO: SPACE")
-            time.sleep(0.1)
-            pyautogui.keyUp('space')
-            time.sleep(0.1)
 
     else:
         # filtro exponencial
@@ -0,0 +1,120 @@
+"""
+Decodificador dos frames de estatisticas do RTOS (main/rtos_stats.h) e do
+relatorio do heap (main/usb_link.h).
+
+Uso: python stats_decoder.py /dev/ttyACM0 [--heap]
+     --heap pede um relatorio do heap_pool a cada frame de estatisticas
+"""
+import struct
+import sys
+
+import serial
+
+from usb_frames import TYPE_HEAP, TYPE_STATS, frames
+
+SUMMARY = struct.Struct('<IIBB')
+NAME_LEN = 12
+TASK = struct.Struct(f'<BBBxHH{NAME_LEN}s')
+QUEUE = struct.Struct('<BxHHH')  # versao < 3
+RING_NAME_LEN = 8
+RING = struct.Struct(f'<{RING_NAME_LEN}sHHHxxI')  # versao >= 3
+CLOCK = struct.Struct('<IIII')  # versao >= 2
+
+HEAP_SUMMARY = struct.Struct('<IIIBx')
+HEAP_CLASS = struct.Struct('<IHHHHIII')
+
+CMD_HEAP_REPORT = b'H'
+
+STATES = {0: 'RUN', 1: 'RDY', 2: 'BLK', 3: 'SUS', 4: 'DEL'}
+
+
+def parse_payload(payload, version=1):
+    uptime_us, window_us, n_tasks, n_entries = SUMMARY.unpack_from(payload, 0)
+    off = SUMMARY.size
+    tasks = []
+    for _ in range(n_tasks):
+        number, prio, state, cpu, stack_free, name = TASK.unpack_from(payload, off)
+        off += TASK.size
+        tasks.append({
+            'number': number,
+            'priority': prio,
+            'state': STATES.get(state, '?'),
+            'cpu': cpu / 10.0,
+            'stack_free_words': stack_free,
+            'name': name.split(b'\0', 1)[0].decode('ascii', 'replace'),
+        })
+    rings = []
+    for _ in range(n_entries):
+        if version >= 3:
+            name, waiting, capacity, peak, overflows = RING.unpack_from(payload, off)
+            off += RING.size
+            name = name.split(b'\0', 1)[0].decode('ascii', 'replace')
+        else:
+            qid, waiting, capacity, peak = QUEUE.unpack_from(payload, off)
+            off += QUEUE.size
+            name, overflows = f'fila {qid}', 0
+        rings.append({'name': name, 'waiting': waiting, 'capacity': capacity, 'peak': peak,
+                      'overflows': overflows})
+    clock = None
+    if version >= 2:
+        samples, clamped, jitter_max, jitter_avg_q4 = CLOCK.unpack_from(payload, off)
+        clock = {'samples': samples, 'clamped': clamped, 'jitter_max_us': jitter_max,
+                 'jitter_avg_us': jitter_avg_q4 / 16.0}
+    return {'uptime_us': uptime_us, 'window_us': window_us, 'tasks': tasks, 'rings': rings,
+            'imu_clock': clock}
+
+
+def parse_heap(payload):
+    free, min_free, wasted, n_classes = HEAP_SUMMARY.unpack_from(payload, 0)
+    off = HEAP_SUMMARY.size
+    classes = []
+    for _ in range(n_classes):
+        size, blocks, in_use, peak, spills, allocs, failures, requested = HEAP_CLASS.unpack_from(payload, off)
+        off += HEAP_CLASS.size
+        classes.append({'size': size, 'blocks': blocks, 'in_use': in_use, 'peak': peak,
+                        'spills': spills, 'allocs': allocs, 'failures': failures,
+                        'requested': requested})
+    return {'free': free, 'min_free': min_free, 'wasted': wasted, 'classes': classes}
+
+
+def print_heap(heap):
+    print(f"heap: livre {heap['free']} B, minimo {heap['min_free']} B, "
+          f"fragmentacao interna {heap['wasted']} B")
+    print(f"{'bloco':>7}{'uso':>9}{'pico':>6}{'spill':>7}{'falhas':>8}{'desperdicio':>13}")
+    for c in heap['classes']:
+        waste = c['size'] * c['in_use'] - c['requested']
+        print(f"{c['size']:>7}{c['in_use']:>5}/{c['blocks']:<3}{c['peak']:>6}{c['spills']:>7}"
+              f"{c['failures']:>8}{waste:>13}")
+
+
+def print_frame(seq, frame):
+    print(f"\n#{seq}  uptime {frame['uptime_us'] / 1e6:.1f} s  janela {frame['window_us'] / 1e3:.0f} ms")
+    print(f"{'task':<14}{'#':>3}{'prio':>5}{'estado':>7}{'cpu%':>7}{'stack livre':>13}")
+    for t in sorted(frame['tasks'], key=lambda t: -t['cpu']):
+        print(f"{t['name']:<14}{t['number']:>3}{t['priority']:>5}{t['state']:>7}"
+              f"{t['cpu']:>7.1f}{t['stack_free_words']:>13}")
+    for r in frame['rings']:
+        print(f"{r['name']}: {r['waiting']}/{r['capacity']} (pico {r['peak']}, descartes {r['overflows']})")
+    c = frame['imu_clock']
+    if c:
+        print(f"imu: {c['samples']} amostras, jitter max {c['jitter_max_us']} us, "
+              f"medio {c['jitter_avg_us']:.1f} us, dt recortado {c['clamped']}")
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__)
+        sys.exit(1)
+    want_heap = '--heap' in sys.argv[2:]
+    ser = serial.Serial(sys.argv[1], 115200, timeout=0.1)
+    for ftype, version, seq, payload in frames(ser):
+        if ftype == TYPE_STATS:
+            print_frame(seq, parse_payload(payload, version))
+            if want_heap:
+                ser.write(CMD_HEAP_REPORT)
+        elif ftype == TYPE_HEAP:
+            print_heap(parse_heap(payload))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,135 @@
+"""
+Converte o dump do trace do kernel (main/usb_link.h) para Chrome trace /
+Perfetto JSON (abrir em chrome://tracing ou ui.perfetto.dev).
+
+Uso:
+  python trace2chrome.py /dev/ttyACM0 trace.json     pede um dump e converte
+  python trace2chrome.py --raw dump.bin trace.json   converte um payload salvo
+"""
+import json
+import struct
+import sys
+
+from usb_frames import TYPE_TRACE, frames
+
+SUMMARY = struct.Struct('<IIHBx')
+NAME_LEN = 12
+NAME = struct.Struct(f'<BB{NAME_LEN}s')
+RECORD = struct.Struct('<IBBH')
+
+CMD_TRACE_DUMP = b'T'
+
+# trace_event_t (freertos/trace_recorder.h)
+TASK_IN, TASK_OUT = 1, 2
+QUEUE_SEND, QUEUE_SEND_ISR, QUEUE_RECEIVE, QUEUE_RECEIVE_ISR, QUEUE_BLOCK = 3, 4, 5, 6, 7
+NOTIFY, NOTIFY_ISR, NOTIFY_TAKE = 8, 9, 10
+ISR_ENTER, ISR_EXIT = 11, 12
+
+INSTANT_NAMES = {
+    QUEUE_SEND: 'send', QUEUE_SEND_ISR: 'send_from_isr',
+    QUEUE_RECEIVE: 'receive', QUEUE_RECEIVE_ISR: 'receive_from_isr',
+    QUEUE_BLOCK: 'block_on_receive',
+    NOTIFY: 'notify', NOTIFY_ISR: 'notify_from_isr', NOTIFY_TAKE: 'notify_take',
+}
+
+KIND_TASK, KIND_QUEUE, KIND_ISR = 0, 1, 2
+ISR_TID_BASE = 1000
+
+
+def parse_dump(payload):
+    _, overwritten, n_records, n_names = SUMMARY.unpack_from(payload, 0)
+    off = SUMMARY.size
+    names = {KIND_TASK: {}, KIND_QUEUE: {}, KIND_ISR: {}}
+    for _ in range(n_names):
+        kind, ident, name = NAME.unpack_from(payload, off)
+        off += NAME.size
+        names.setdefault(kind, {})[ident] = name.split(b'\0', 1)[0].decode('ascii', 'replace')
+    records = []
+    last, high = None, 0
+    for _ in range(n_records):
+        ts, etype, ident, arg = RECORD.unpack_from(payload, off)
+        off += RECORD.size
+        # desfaz o wrap do contador de 32 bits
+        if last is not None and ts < last:
+            high += 1 << 32
+        last = ts
+        records.append((ts + high, etype, ident, arg))
+    return overwritten, names, records
+
+
+def to_chrome(names, records):
+    events = []
+    task_names = names[KIND_TASK]
+    for tid, name in task_names.items():
+        events.append({'ph': 'M', 'name': 'thread_name', 'pid': 1, 'tid': tid, 'args': {'name': name}})
+    events.append({'ph': 'M', 'name': 'thread_name', 'pid': 1, 'tid': ISR_TID_BASE,
+                   'args': {'name': 'FromISR API'}})
+    for isr, name in names[KIND_ISR].items():
+        events.append({'ph': 'M', 'name': 'thread_name', 'pid': 1, 'tid': ISR_TID_BASE + isr,
+                       'args': {'name': f'ISR {name}'}})
+
+    running = {}
+    isr_open = {}
+    current = None
+    for ts, etype, ident, arg in records:
+        if etype == TASK_IN:
+            running[ident] = ts
+            current = ident
+        elif etype == TASK_OUT:
+            start = running.pop(ident, None)
+            if start is not None:
+                events.append({'ph': 'X', 'name': task_names.get(ident, f'task {ident}'),
+                               'pid': 1, 'tid': ident, 'ts': start, 'dur': ts - start})
+        elif etype == ISR_ENTER:
+            isr_open[ident] = ts
+        elif etype == ISR_EXIT:
+            start = isr_open.pop(ident, None)
+            if start is not None:
+                events.append({'ph': 'X', 'name': names[KIND_ISR].get(ident, f'isr {ident}'),
+                               'pid': 1, 'tid': ISR_TID_BASE + ident, 'ts': start, 'dur': ts - start})
+        elif etype in INSTANT_NAMES:
+            if etype in (NOTIFY, NOTIFY_ISR, NOTIFY_TAKE):
+                target = task_names.get(ident, f'task {ident}')
+                args = {'task': target, 'index': arg}
+            else:
+                args = {'queue': names[KIND_QUEUE].get(ident, f'queue {ident}'), 'waiting': arg}
+            from_isr = etype in (QUEUE_SEND_ISR, QUEUE_RECEIVE_ISR, NOTIFY_ISR)
+            tid = ISR_TID_BASE if from_isr or current is None else current
+            events.append({'ph': 'i', 's': 't', 'name': INSTANT_NAMES[etype],
+                           'pid': 1, 'tid': tid, 'ts': ts, 'args': args})
+    return {'traceEvents': events}
+
+
+def request_dump(port):
+    import serial
+    ser = serial.Serial(port, 115200, timeout=0.1)
+    ser.reset_input_buffer()
+    ser.write(CMD_TRACE_DUMP)
+    for ftype, _, _, payload in frames(ser):
+        if ftype == TYPE_TRACE:
+            return payload
+
+
+def main():
+    args = sys.argv[1:]
+    if len(args) == 3 and args[0] == '--raw':
+        with open(args[1], 'rb') as f:
+            payload = f.read()
+        out = args[2]
+    elif len(args) == 2:
+        payload = request_dump(args[0])
+        with open(args[1] + '.bin', 'wb') as f:
+            f.write(payload)
+        out = args[1]
+    else:
+        print(__doc__)
+        sys.exit(1)
+
+    overwritten, names, records = parse_dump(payload)
+    with open(out, 'w') as f:
+        json.dump(to_chrome(names, records), f)
+    print(f"{len(records)} eventos ({overwritten} sobrescritos) -> {out}")
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,50 @@
+"""
+Leitura dos frames binarios enviados pela USB CDC (main/usb_frame.h).
+"""
+import struct
+
+MAGIC = b'\xA5\x5A'
+HEADER = struct.Struct('<2sBBHH')
+
+TYPE_STATS = 0x01
+TYPE_TRACE = 0x02
+TYPE_HEAP = 0x03
+
+
+def crc16(data):
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def frames(stream):
+    """Gera (tipo, versao, seq, payload) validos, ressincronizando pelo magic."""
+    buf = bytearray()
+    while True:
+        chunk = stream.read(stream.in_waiting or 1)
+        if not chunk:
+            continue
+        buf.extend(chunk)
+        while True:
+            idx = buf.find(MAGIC)
+            if idx < 0:
+                del buf[:-1]
+                break
+            del buf[:idx]
+            if len(buf) < HEADER.size:
+                break
+            _, ftype, version, seq, length = HEADER.unpack_from(buf, 0)
+            total = HEADER.size + length + 2
+            if len(buf) < total:
+                break
+            crc, = struct.unpack_from('<H', buf, HEADER.size + length)
+            if crc16(buf[:HEADER.size + length]) != crc:
+                del buf[:2]
+                continue
+            payload = bytes(buf[HEADER.size:HEADER.size + length])
+            del buf[:total]
+            yield ftype, version, seq, payload
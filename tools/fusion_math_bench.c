@@ -0,0 +1,116 @@
+/*
+ * Precisao e velocidade do FusionFastMath.h contra a libm, no host.
+ *
+ *   cc -O2 -IFusion tools/fusion_math_bench.c Fusion/FusionFastMath.c -lm \
+ *      -o fusion_math_bench && ./fusion_math_bench
+ *
+ * Varre cada funcao numa grade densa do dominio, imprime o erro maximo
+ * (absoluto; relativo para o rsqrt) e o tempo por chamada das duas versoes.
+ * Os erros documentados em FusionFastMath.h saem daqui. O tempo no host so
+ * serve de comparacao relativa: no RP2040 a libm passa pela soft-float da
+ * ROM e a diferenca e bem maior.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "FusionFastMath.h"
+
+#define SWEEP_POINTS 2000000
+#define TIMING_CALLS 20000000
+
+static volatile float sink;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+typedef float (*unary_t)(float);
+
+static float fast_asin(float x) { return FusionFastAsin(x); }
+static float libm_asin(float x) { return asinf(x); }
+static float fast_rsqrt(float x) { return FusionFastInverseSqrtRefined(x); }
+static float libm_rsqrt(float x) { return 1.0f / sqrtf(x); }
+static float fast_sin(float x) { return FusionFastSin(x); }
+static float libm_sin(float x) { return sinf(x); }
+static float fast_cos(float x) { return FusionFastCos(x); }
+static float libm_cos(float x) { return cosf(x); }
+
+// Erro maximo de f contra a referencia em double, em [lo, hi]
+static double sweep(unary_t f, double (*ref)(double), double lo, double hi, int relative) {
+    double worst = 0;
+    for (int i = 0; i <= SWEEP_POINTS; i++) {
+        float x = (float)(lo + (hi - lo) * i / SWEEP_POINTS);
+        double expected = ref(x);
+        double err = fabs(f(x) - expected);
+        if (relative) {
+            err /= fabs(expected);
+        }
+        if (err > worst) {
+            worst = err;
+        }
+    }
+    return worst;
+}
+
+static double rsqrt_ref(double x) { return 1.0 / sqrt(x); }
+
+static double time_unary(unary_t f, float lo, float hi) {
+    float step = (hi - lo) / TIMING_CALLS;
+    float acc = 0;
+    double t0 = now_s();
+    for (int i = 0; i < TIMING_CALLS; i++) {
+        acc += f(lo + step * i);
+    }
+    sink = acc;
+    return (now_s() - t0) * 1e9 / TIMING_CALLS;
+}
+
+static void report_unary(const char *name, unary_t fast, unary_t libm, double (*ref)(double),
+                         double lo, double hi, int relative) {
+    printf("%-28s max %s err %.2e  fast %5.1f ns  libm %5.1f ns\n", name,
+           relative ? "rel" : "abs", sweep(fast, ref, lo, hi, relative),
+           time_unary(fast, lo, hi), time_unary(libm, lo, hi));
+}
+
+static void report_atan2(void) {
+    double worst = 0;
+    for (int i = 0; i < SWEEP_POINTS; i++) {
+        double a = -M_PI + 2 * M_PI * i / SWEEP_POINTS;
+        float y = (float)sin(a), x = (float)cos(a);
+        double err = fabs(FusionFastAtan2(y, x) - atan2((double)y, (double)x));
+        if (err > M_PI) {
+            err = 2 * M_PI - err; // -pi e pi sao o mesmo angulo
+        }
+        if (err > worst) {
+            worst = err;
+        }
+    }
+
+    float acc = 0;
+    double t0 = now_s();
+    for (int i = 0; i < TIMING_CALLS; i++) {
+        acc += FusionFastAtan2((float)(i & 1023) - 512.0f, (float)(i >> 10 & 1023) - 512.0f);
+    }
+    double fast = (now_s() - t0) * 1e9 / TIMING_CALLS;
+    t0 = now_s();
+    for (int i = 0; i < TIMING_CALLS; i++) {
+        acc += atan2f((float)(i & 1023) - 512.0f, (float)(i >> 10 & 1023) - 512.0f);
+    }
+    double libm = (now_s() - t0) * 1e9 / TIMING_CALLS;
+    sink = acc;
+
+    printf("%-28s max abs err %.2e  fast %5.1f ns  libm %5.1f ns\n", "FusionFastAtan2", worst, fast, libm);
+}
+
+int main(void) {
+    report_atan2();
+    report_unary("FusionFastAsin", fast_asin, libm_asin, asin, -1.0, 1.0, 0);
+    report_unary("FusionFastSin", fast_sin, libm_sin, sin, -100.0, 100.0, 0);
+    report_unary("FusionFastCos", fast_cos, libm_cos, cos, -100.0, 100.0, 0);
+    report_unary("FusionFastSin (-pi..pi)", fast_sin, libm_sin, sin, -M_PI, M_PI, 0);
+    report_unary("FusionFastInverseSqrtRefined", fast_rsqrt, libm_rsqrt, rsqrt_ref, 1e-6, 1e6, 1);
+    return 0;
+}
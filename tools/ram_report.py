@@ -0,0 +1,69 @@
+"""
+Relatorio de RAM dos objetos estaticos do RTOS.
+
+Le a tabela de simbolos do ELF (nm), soma todo simbolo com prefixo
+`rtos_static_` (ver main/rtos_static.h), os buffers estaticos do proprio
+kernel e o framebuffer do OLED, e falha (exit 1) se o total passar do
+orcamento. Chamado como POST_BUILD quando RTOS_STATIC_ALLOCATION=ON.
+
+Uso: python ram_report.py --nm arm-none-eabi-nm --budget 65536 [--output f] app.elf
+"""
+import argparse
+import subprocess
+import sys
+
+PREFIX = 'rtos_static_'
+# Objetos estaticos criados pelo kernel / bibliotecas, fora do prefixo
+EXTRA_SYMBOLS = ('xStaticTimerQueue', 'ucStaticTimerQueueStorage', 'gfx_framebuffers')
+RAM_SECTIONS = 'bBdD'  # .bss / .data (locais e globais)
+
+RP2040_SRAM = 264 * 1024
+
+
+def read_symbols(nm, elf):
+    out = subprocess.run([nm, '-S', '-t', 'd', elf], check=True,
+                         capture_output=True, text=True).stdout
+    symbols = []
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) != 4 or parts[2] not in RAM_SECTIONS:
+            continue
+        _, size, _, name = parts
+        # estaticos locais podem vir com sufixo (.0, .lto_priv.0, ...)
+        base = name.split('.', 1)[0]
+        if base.startswith(PREFIX) or base in EXTRA_SYMBOLS:
+            symbols.append((base, int(size)))
+    return symbols
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--nm', default='arm-none-eabi-nm')
+    parser.add_argument('--budget', type=int, required=True)
+    parser.add_argument('--output')
+    parser.add_argument('elf')
+    args = parser.parse_args()
+
+    symbols = sorted(read_symbols(args.nm, args.elf), key=lambda s: -s[1])
+    total = sum(size for _, size in symbols)
+
+    lines = [f"{'objeto':<40}{'bytes':>10}"]
+    lines += [f'{name:<40}{size:>10}' for name, size in symbols]
+    lines.append('-' * 50)
+    lines.append(f"{'total':<40}{total:>10}")
+    lines.append(f"{'orcamento':<40}{args.budget:>10}")
+    lines.append(f'{100.0 * total / RP2040_SRAM:.1f}% da SRAM do RP2040')
+    report = '\n'.join(lines)
+
+    print(report)
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(report + '\n')
+
+    if total > args.budget:
+        print(f'erro: objetos do RTOS usam {total} bytes, orcamento e {args.budget}', file=sys.stderr)
+        sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,255 @@
+"""
+Analise estatica de pilha por task.
+
+Le os arquivos .ci gerados pelo GCC com -fcallgraph-info=su (grafo de
+chamadas + bytes de pilha de cada funcao), calcula o pior caso de
+profundidade a partir da funcao de entrada de cada task e gera um header
+com os tamanhos de pilha (em palavras) ja com margem.
+
+Uso:
+  python stack_usage.py --output stack_sizes.h [--report relatorio.txt]
+      --task BUTTON=task_button_serial --task JOYSTICK=x_task,y_task ...
+      --default BUTTON=512 ... <diretorios com .ci>
+
+Chamadas que o grafo nao resolve (ponteiro de funcao, codigo em assembly
+ou bibliotecas pre-compiladas) custam --unknown-cost bytes e aparecem no
+relatorio; recursao e pilha dinamica tambem sao sinalizadas.
+
+Funcoes embrulhadas pelo linker (-Wl,--wrap, como o printf do SDK) sao
+resolvidas para o corpo __wrap_<nome>, e as chamadas por ponteiro dos
+drivers de stdio seguem INDIRECT_CALLS, entao a cadeia do printf ate a
+USB entra no pior caso.
+
+Com --pool-config, as classes do heap_pool (configHEAP_POOL_OBJECT_CLASSES
+do FreeRTOSConfig.h) sao somadas a um bloco por pilha calculada e o header
+gerado tambem define configHEAP_POOL_CLASSES: as pilhas menores liberam
+SRAM de verdade e toda task tem um bloco do tamanho certo.
+"""
+import argparse
+import math
+import os
+import re
+import sys
+
+NODE_RE = re.compile(r'node: \{ title: "([^"]*)" label: "([^"]*)"( shape : ellipse)?')
+EDGE_RE = re.compile(r'edge: \{ sourcename: "([^"]*)" targetname: "([^"]*)"')
+BYTES_RE = re.compile(r'(\d+) bytes \(([a-z,]+)\)')
+
+# Custo conhecido de rotinas sem .ci (ROM / assembly do SDK e libgcc)
+KNOWN_COSTS = {
+    '__aeabi_fadd': 16, '__aeabi_fsub': 16, '__aeabi_fmul': 16, '__aeabi_fdiv': 16,
+    '__aeabi_i2f': 16, '__aeabi_ui2f': 16, '__aeabi_f2iz': 16, '__aeabi_f2uiz': 16,
+    '__aeabi_fcmplt': 16, '__aeabi_fcmpgt': 16, '__aeabi_fcmple': 16, '__aeabi_fcmpge': 16,
+    '__aeabi_fcmpeq': 16, '__aeabi_f2d': 16, '__aeabi_d2f': 16,
+    '__aeabi_idiv': 8, '__aeabi_uidiv': 8, '__aeabi_idivmod': 8, '__aeabi_uidivmod': 8,
+    '__aeabi_memcpy': 16, '__aeabi_memset': 16, 'memcpy': 16, 'memset': 16, 'strlen': 8,
+    'sqrtf': 32, 'atan2f': 48, 'asinf': 48, 'powf': 64, 'sinf': 48, 'cosf': 48,
+    # Limite superior da familia printf quando o pico_printf nao tem .ci
+    # (build com PICO_PRINTF_NONE/newlib): _vsnprintf + _ftoa/_etoa com os
+    # buffers de conversao, mais a saida pelo stdio_usb (tud_cdc_write)
+    'printf': 640, 'vprintf': 640, 'snprintf': 560, 'vsnprintf': 560,
+    'puts': 320, 'putchar': 320,
+}
+
+# Chamadas por ponteiro que o grafo mostra como __indirect_call: destinos
+# possiveis (os drivers de stdio habilitados no pico_emb)
+INDIRECT_CALLS = {
+    'stdio_out_chars_crlf': ['stdio_usb_out_chars'],
+    'stdio_out_chars_no_crlf': ['stdio_usb_out_chars'],
+    'stdio_flush': ['stdio_usb_out_flush'],
+}
+
+POOL_CLASS_RE = re.compile(r'X\(\s*(\d+)\s*,\s*(\d+)\s*\)')
+
+# Cortex-M0+: 8 palavras empilhadas na entrada de excecao + r4-r11 salvos
+# pelo PendSV + 4 palavras do divisor do SIO salvas pelo port.c
+CONTEXT_BYTES = (8 + 8 + 4) * 4
+
+
+def load_graph(dirs):
+    frames = {}
+    external = set()
+    dynamic = set()
+    edges = {}
+    for d in dirs:
+        for root, _, files in os.walk(d):
+            for name in files:
+                if not name.endswith('.ci'):
+                    continue
+                with open(os.path.join(root, name), errors='replace') as f:
+                    text = f.read()
+                for title, label, ellipse in NODE_RE.findall(text):
+                    m = BYTES_RE.search(label)
+                    if m:
+                        # a mesma funcao pode aparecer em varios .ci: fica o pior
+                        frames[title] = max(frames.get(title, 0), int(m.group(1)))
+                        if 'dynamic' in m.group(2):
+                            dynamic.add(title)
+                    elif ellipse:
+                        external.add(title)
+                for src, dst in EDGE_RE.findall(text):
+                    edges.setdefault(src, set()).add(dst)
+    return frames, external - set(frames), dynamic, edges
+
+
+class Analyzer:
+    def __init__(self, frames, dynamic, edges, unknown_cost):
+        self.frames = frames
+        self.dynamic = dynamic
+        self.edges = edges
+        self.unknown_cost = unknown_cost
+        self.memo = {}
+        self.unknown = set()
+        self.recursive = set()
+
+    def resolve(self, fn):
+        # printf e cia. sao --wrap: a chamada aponta para o nome original
+        if fn not in self.frames and '__wrap_' + fn in self.frames:
+            return '__wrap_' + fn
+        return fn
+
+    def callees(self, fn):
+        for callee in self.edges.get(fn, ()):
+            if callee == '__indirect_call' and fn in INDIRECT_CALLS:
+                yield from INDIRECT_CALLS[fn]
+            else:
+                yield self.resolve(callee)
+
+    def cost(self, fn):
+        if fn in self.frames:
+            return self.frames[fn]
+        if fn in KNOWN_COSTS:
+            return KNOWN_COSTS[fn]
+        self.unknown.add(fn)
+        return self.unknown_cost
+
+    def depth(self, fn, stack=()):
+        """Retorna (bytes, caminho) do pior caso a partir de fn."""
+        if fn in self.memo:
+            return self.memo[fn]
+        if fn in stack:
+            self.recursive.add(fn)
+            return 0, []
+        best, best_path = 0, []
+        for callee in self.callees(fn):
+            d, path = self.depth(callee, stack + (fn,))
+            if d > best:
+                best, best_path = d, path
+        result = (self.cost(fn) + best, [fn] + best_path)
+        self.memo[fn] = result
+        return result
+
+
+def load_pool_classes(config):
+    """Le configHEAP_POOL_OBJECT_CLASSES do FreeRTOSConfig.h."""
+    with open(config) as f:
+        text = f.read()
+    m = re.search(r'#define\s+configHEAP_POOL_OBJECT_CLASSES\(X\)((?:.*\\\n)*.*)', text)
+    if not m:
+        print(f'erro: configHEAP_POOL_OBJECT_CLASSES nao encontrado em {config}', file=sys.stderr)
+        sys.exit(1)
+    classes = {}
+    for size, count in POOL_CLASS_RE.findall(m.group(1)):
+        classes[int(size)] = classes.get(int(size), 0) + int(count)
+    return classes
+
+
+def parse_pairs(items):
+    out = {}
+    for item in items:
+        key, _, value = item.partition('=')
+        out[key] = value
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--output', required=True)
+    parser.add_argument('--report')
+    parser.add_argument('--task', action='append', default=[],
+                        help='NOME=entrada[,entrada...] -> TASK_STACK_NOME')
+    parser.add_argument('--default', action='append', default=[],
+                        help='NOME=palavras, usado se a entrada nao foi compilada')
+    parser.add_argument('--margin', type=float, default=25.0, help='margem em %%')
+    parser.add_argument('--min-words', type=int, default=128)
+    parser.add_argument('--unknown-cost', type=int, default=128)
+    parser.add_argument('--pool-config',
+                        help='FreeRTOSConfig.h: gera configHEAP_POOL_CLASSES com as pilhas')
+    parser.add_argument('dirs', nargs='+')
+    args = parser.parse_args()
+
+    frames, external, dynamic, edges = load_graph(args.dirs)
+    if not frames:
+        print('erro: nenhum .ci encontrado (compilar com -fcallgraph-info=su)', file=sys.stderr)
+        sys.exit(1)
+
+    analyzer = Analyzer(frames, dynamic, edges, args.unknown_cost)
+    tasks = {k: v.split(',') for k, v in parse_pairs(args.task).items()}
+    defaults = {k: int(v) for k, v in parse_pairs(args.default).items()}
+
+    defines, report = [], []
+    stacks = []  # (bytes, tasks): so as entradas compiladas viram task
+    for name, entries in tasks.items():
+        found = [e for e in entries if e in frames]
+        if not found:
+            words = defaults.get(name, args.min_words)
+            defines.append((name, words, 'entrada nao compilada, valor padrao'))
+            report.append(f'{name}: {",".join(entries)} nao encontrada, {words} palavras')
+            continue
+
+        worst, path = max(analyzer.depth(e) for e in found)
+        total = worst + CONTEXT_BYTES
+        words = max(args.min_words, math.ceil(total * (1 + args.margin / 100) / 4))
+        defines.append((name, words, f'pior caso {total} bytes'))
+        stacks.append((words * 4, len(found)))
+        report.append(f'{name}: {total} bytes -> {words} palavras')
+        report.append('    ' + ' -> '.join(f'{fn}({analyzer.cost(fn)})' for fn in path))
+
+    if analyzer.unknown:
+        report.append(f'custo desconhecido ({args.unknown_cost} bytes cada): '
+                      + ', '.join(sorted(analyzer.unknown)))
+    if analyzer.recursive:
+        report.append('recursao (profundidade nao limitada): ' + ', '.join(sorted(analyzer.recursive)))
+    used_dynamic = dynamic & set(analyzer.memo)
+    if used_dynamic:
+        report.append('pilha dinamica (alloca/VLA): ' + ', '.join(sorted(used_dynamic)))
+
+    lines = [
+        '// Gerado por tools/stack_usage.py a partir de -fcallgraph-info. Nao editar.',
+        f'// Margem de {args.margin:g}% sobre o pior caso + {CONTEXT_BYTES} bytes de contexto.',
+        '#ifndef STACK_SIZES_H_',
+        '#define STACK_SIZES_H_',
+        '',
+    ]
+    for name, words, note in defines:
+        lines.append(f'#define TASK_STACK_{name:<16} {words:>5} // {note}')
+
+    if args.pool_config:
+        # Um bloco por pilha, no tamanho exato (multiplo de 8); tamanhos
+        # iguais aos dos objetos do kernel entram na mesma classe
+        classes = load_pool_classes(args.pool_config)
+        for size, count in stacks:
+            size = (size + 7) & ~7
+            classes[size] = classes.get(size, 0) + count
+        lines += ['', '// Classes do heap_pool: objetos do kernel + uma pilha por task',
+                  '#define configHEAP_POOL_CLASSES(X) \\']
+        lines += [f'    X({size}, {count}) \\' for size, count in sorted(classes.items())]
+        lines.append('')
+        report.append('heap_pool: ' + ', '.join(f'{size}x{count}' for size, count in sorted(classes.items()))
+                      + f' = {sum(s * c for s, c in classes.items())} bytes')
+    lines += ['', '#endif // STACK_SIZES_H_', '']
+
+    text = '\n'.join(lines)
+    # So reescreve se mudou, para nao recompilar tudo a cada build
+    if not os.path.exists(args.output) or open(args.output).read() != text:
+        with open(args.output, 'w') as f:
+            f.write(text)
+
+    print('\n'.join(report))
+    if args.report:
+        with open(args.report, 'w') as f:
+            f.write('\n'.join(report) + '\n')
+
+
+if __name__ == '__main__':
+    main()